@@ -15,10 +15,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "history/history_item.h"
 #include "main/main_session.h"
+#include "ui/text/text_entity.h"
 
 namespace Api {
 namespace {
 
+constexpr auto kMaxCompleteResults = 16;
+
 [[nodiscard]] MessageIdsList HistoryItemsFromTL(
 		not_null<Data::Session*> data,
 		const QVector<MTPMessage> &messages) {
@@ -41,6 +44,23 @@ namespace {
 	return result;
 }
 
+[[nodiscard]] bool MatchesWords(
+		not_null<HistoryItem*> item,
+		const QStringList &words) {
+	if (item->media()) {
+		// The server could have matched a file name or some other media
+		// field that we can't check here, so keep those messages.
+		return true;
+	}
+	const auto parts = TextUtilities::PrepareSearchWords(
+		item->originalText().text);
+	return ranges::all_of(words, [&](const QString &word) {
+		return ranges::any_of(parts, [&](const QString &part) {
+			return part.startsWith(word);
+		});
+	});
+}
+
 } // namespace
 
 MessagesSearch::MessagesSearch(not_null<History*> history)
@@ -75,6 +95,11 @@ void MessagesSearch::searchRequest() {
 			_requestId = 0;
 			searchReceived(it->second, _requestId, nextToken);
 			return;
+		} else if (auto found = searchLocally(nextToken)) {
+			// The server may match more than the local filter does,
+			// stemming or links for example, so request it anyway.
+			// Its first page replaces this provisional one.
+			_messagesFounds.fire(std::move(*found));
 		}
 	}
 	auto callback = [=](Fn<void()> finish) {
@@ -169,7 +194,24 @@ void MessagesSearch::searchReceived(
 		return FoundMessages{};
 	});
 	if (!_offsetId) {
-		_cacheOfStartByToken.emplace(nextToken, result);
+		const auto inserted = _cacheOfStartByToken.emplace(
+			nextToken,
+			result).second;
+		if (inserted
+			&& found.total >= 0
+			&& found.total <= int(found.messages.size())) {
+			auto words = TextUtilities::PrepareSearchWords(_query);
+			if (!words.isEmpty()) {
+				if (_completeResults.size() >= kMaxCompleteResults) {
+					_completeResults.erase(begin(_completeResults));
+				}
+				_completeResults.push_back({
+					.words = std::move(words),
+					.from = _from,
+					.messages = found.messages,
+				});
+			}
+		}
 	}
 	_requestId = 0;
 	_offsetId = found.messages.empty()
@@ -178,6 +220,46 @@ void MessagesSearch::searchReceived(
 	_messagesFounds.fire(std::move(found));
 }
 
+std::optional<FoundMessages> MessagesSearch::searchLocally(
+		const QString &nextToken) const {
+	const auto words = TextUtilities::PrepareSearchWords(_query);
+	if (words.isEmpty()) {
+		return std::nullopt;
+	}
+
+	// If every word of a complete result is a prefix of some word of
+	// the new query, most of the new results are in that complete one.
+	const auto narrows = [&](const CompleteResult &complete) {
+		return (complete.from == _from)
+			&& ranges::all_of(complete.words, [&](const QString &was) {
+				return ranges::any_of(words, [&](const QString &now) {
+					return now.startsWith(was);
+				});
+			});
+	};
+	const auto i = ranges::find_if(_completeResults, narrows);
+	if (i == end(_completeResults)) {
+		return std::nullopt;
+	}
+	auto &owner = _history->owner();
+	auto messages = MessageIdsList();
+	for (const auto &id : i->messages) {
+		const auto item = owner.message(id);
+		if (!item) {
+			return std::nullopt;
+		} else if (MatchesWords(item, words)) {
+			messages.push_back(id);
+		}
+	}
+	const auto total = int(messages.size());
+	return FoundMessages{
+		.total = total,
+		.messages = std::move(messages),
+		.nextToken = nextToken + u":local"_q,
+		.provisional = true,
+	};
+}
+
 rpl::producer<FoundMessages> MessagesSearch::messagesFounds() const {
 	return _messagesFounds.events();
 }
@@ -17,6 +17,7 @@ struct FoundMessages {
 	int total = -1;
 	MessageIdsList messages;
 	QString nextToken;
+	bool provisional = false;
 };
 
 class MessagesSearch final {
@@ -27,20 +28,33 @@ public:
 	void searchMessages(const QString &query, PeerData *from);
 	void searchMore();
 
+	// A provisional first page filtered locally from earlier results
+	// may come before the server one, with a nextToken of its own.
 	[[nodiscard]] rpl::producer<FoundMessages> messagesFounds() const;
 
 private:
 	using TLMessages = MTPmessages_Messages;
+	struct CompleteResult {
+		QStringList words;
+		PeerData *from = nullptr;
+		MessageIdsList messages;
+	};
+
 	void searchRequest();
 	void searchReceived(
 		const TLMessages &result,
 		mtpRequestId requestId,
 		const QString &nextToken);
+	[[nodiscard]] std::optional<FoundMessages> searchLocally(
+		const QString &nextToken) const;
 
 	const not_null<History*> _history;
 
 	base::flat_map<QString, TLMessages> _cacheOfStartByToken;
 
+	// Results that were received in full in a single slice.
+	std::vector<CompleteResult> _completeResults;
+
 	QString _query;
 	PeerData *_from = nullptr;
 	MsgId _offsetId;
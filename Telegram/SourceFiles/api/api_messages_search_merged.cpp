@@ -43,14 +43,33 @@ MessagesSearchMerged::MessagesSearchMerged(not_null<History*> history)
 
 	_apiSearch.messagesFounds(
 	) | rpl::start_with_next([=](const FoundMessages &data) {
-		if (data.nextToken == _concatedFound.nextToken) {
+		if (data.provisional) {
+			// Shown until the server page replaces it,
+			// so it can't mark the search as full.
+			if (!_waitingForTotal) {
+				_concatedFound = data;
+				_newFounds.fire({});
+			}
+		} else if (data.nextToken == _concatedFound.nextToken) {
 			addFound(data);
 			checkFull(data);
 			_nextFounds.fire({});
 		} else {
+			const auto replaced = _concatedFound.provisional
+				? int(_concatedFound.messages.size())
+				: -1;
 			_concatedFound = data;
 			checkFull(data);
 			checkWaitingForTotal();
+			if (replaced >= 0) {
+				DEBUG_LOG(("Search Info: "
+					"%1 provisional results replaced by %2 (%3 unique)."
+					).arg(replaced
+					).arg(data.messages.size()
+					).arg(int(base::flat_set<FullMsgId>(
+						begin(_concatedFound.messages),
+						end(_concatedFound.messages)).size())));
+			}
 		}
 	}, _lifetime);
 
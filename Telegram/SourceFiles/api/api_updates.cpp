@@ -68,6 +68,10 @@ constexpr auto kNoUpdatesTimeout = 60 * 1000;
 // If nothing is received in 1 min when was a sleepmode we ping.
 constexpr auto kNoUpdatesAfterSleepTimeout = 60 * crl::time(1000);
 
+// Large differences are applied in chunks between event loop iterations.
+constexpr auto kDifferenceChunkBudget = crl::time(8);
+constexpr auto kDifferenceChunkMessages = 16;
+
 enum class DataIsLoadedResult {
 	NotLoaded = 0,
 	FromNotLoaded = 1,
@@ -91,6 +95,32 @@ void ProcessScheduledMessageWithElapsedTime(
 	}
 }
 
+[[nodiscard]] QVector<MTPMessage> SortDifferenceMessages(
+		QVector<MTPMessage> messages) {
+	// Same order as in Data::Session::processMessages.
+	ranges::stable_sort(messages, std::less<>(), [](const MTPMessage &entry) {
+		return uint32(IdFromMessage(entry).bare);
+	});
+	return messages;
+}
+
+[[nodiscard]] QVector<MTPUpdate> SortDifferenceUpdates(
+		const MTPVector<MTPUpdate> &updates) {
+	// Same order as in Updates::feedUpdateVector, message ids are
+	// already applied before the new messages.
+	auto result = QVector<MTPUpdate>();
+	result.reserve(updates.v.size());
+	for (const auto &update : updates.v) {
+		if (update.type() != mtpc_updateMessageID) {
+			result.push_back(update);
+		}
+	}
+	ranges::stable_sort(result, std::less<>(), [](const MTPUpdate &entry) {
+		return (entry.type() == mtpc_updateGroupCallParticipants) ? 0 : 1;
+	});
+	return result;
+}
+
 bool IsForceLogoutNotification(const MTPDupdateServiceNotification &data) {
 	return qs(data.vtype()).startsWith(qstr("AUTH_KEY_DROP_"));
 }
@@ -363,6 +393,11 @@ void Updates::setState(int32 pts, int32 date, int32 qts, int32 seq) {
 void Updates::channelDifferenceDone(
 		not_null<ChannelData*> channel,
 		const MTPupdates_ChannelDifference &difference) {
+	if (postponeWhileApplyingDifference([=] {
+		channelDifferenceDone(channel, difference);
+	})) {
+		return;
+	}
 	_channelFailDifferenceTimeout.remove(channel);
 
 	const auto timeout = difference.match([&](const auto &data) {
@@ -467,23 +502,21 @@ void Updates::differenceDone(const MTPupdates_Difference &result) {
 	} break;
 	case mtpc_updates_differenceSlice: {
 		auto &d = result.c_updates_differenceSlice();
-		feedDifference(d.vusers(), d.vchats(), d.vnew_messages(), d.vother_updates());
-
-		auto &s = d.vintermediate_state().c_updates_state();
-		setState(s.vpts().v, s.vdate().v, s.vqts().v, s.vseq().v);
-
-		_ptsWaiter.setRequesting(false);
-
-		MTP_LOG(0, ("getDifference "
-			"{ good - after a slice of difference was received }%1"
-			).arg(_session->mtp().isTestMode() ? " TESTMODE" : ""));
-		getDifference();
+		feedDifference(
+			result,
+			d.vusers(),
+			d.vchats(),
+			d.vnew_messages(),
+			d.vother_updates());
 	} break;
 	case mtpc_updates_difference: {
 		auto &d = result.c_updates_difference();
-		feedDifference(d.vusers(), d.vchats(), d.vnew_messages(), d.vother_updates());
-
-		stateDone(d.vstate());
+		feedDifference(
+			result,
+			d.vusers(),
+			d.vchats(),
+			d.vnew_messages(),
+			d.vother_updates());
 	} break;
 	case mtpc_updates_differenceTooLong: {
 		LOG(("API Error: updates.differenceTooLong is not supported by Telegram Desktop!"));
@@ -577,16 +610,142 @@ bool Updates::updateAndApply(int32 pts, int32 ptsCount) {
 }
 
 void Updates::feedDifference(
+		const MTPupdates_Difference &result,
 		const MTPVector<MTPUser> &users,
 		const MTPVector<MTPChat> &chats,
 		const MTPVector<MTPMessage> &msgs,
 		const MTPVector<MTPUpdate> &other) {
+	Expects(!_differenceApplying.has_value());
+
+	const auto started = crl::now();
 	Core::App().checkAutoLock();
 	session().data().processUsers(users);
 	session().data().processChats(chats);
 	feedMessageIds(other);
-	session().data().processMessages(msgs, NewMessageType::Unread);
-	feedUpdateVector(other, SkipUpdatePolicy::SkipMessageIds);
+
+	// Like Data::Session::processMessages all existing messages are
+	// updated before any new message is added, only new ones are chunked.
+	auto messages = QVector<MTPMessage>();
+	messages.reserve(msgs.v.size());
+	for (const auto &message : msgs.v) {
+		if (message.type() != mtpc_message
+			|| !session().data().updateExistingMessage(message.c_message())) {
+			messages.push_back(message);
+		}
+	}
+
+	// The pts state is set only after everything is applied, while
+	// the difference is still marked as requesting in _ptsWaiter.
+	// Updates and channel differences that arrive in between chunks
+	// are postponed until then, so they can't overtake the difference.
+	_differenceApplying = DifferenceApplying{
+		.result = result,
+		.messages = SortDifferenceMessages(std::move(messages)),
+		.updates = SortDifferenceUpdates(other),
+		.started = started,
+		.busy = crl::now() - started,
+	};
+	feedDifferenceChunk();
+}
+
+void Updates::feedDifferenceChunk() {
+	Expects(_differenceApplying.has_value());
+
+	auto &applying = *_differenceApplying;
+	const auto started = crl::now();
+	const auto till = started + kDifferenceChunkBudget;
+	const auto messagesCount = int(applying.messages.size());
+	applying.inChunk = true;
+	while (applying.messagesApplied < messagesCount) {
+		const auto count = std::min(
+			kDifferenceChunkMessages,
+			messagesCount - applying.messagesApplied);
+		for (auto i = 0; i != count; ++i) {
+			session().data().addNewMessage(
+				applying.messages[applying.messagesApplied++],
+				MessageFlags(),
+				NewMessageType::Unread);
+		}
+		if (crl::now() >= till) {
+			break;
+		}
+	}
+	const auto updatesCount = int(applying.updates.size());
+	if (applying.messagesApplied == messagesCount) {
+		while (applying.updatesApplied < updatesCount
+			&& crl::now() < till) {
+			feedUpdate(applying.updates[applying.updatesApplied++]);
+		}
+	}
+	session().data().sendHistoryChangeNotifications();
+	applying.inChunk = false;
+
+	applying.busy += crl::now() - started;
+	++applying.chunks;
+	if (applying.messagesApplied < messagesCount
+		|| applying.updatesApplied < updatesCount) {
+		crl::on_main(_session, [=] {
+			feedDifferenceChunk();
+		});
+	} else {
+		finishDifference();
+	}
+}
+
+void Updates::finishDifference() {
+	Expects(_differenceApplying.has_value());
+
+	const auto applying = base::take(_differenceApplying);
+	DEBUG_LOG(("Updates: difference with %1 messages and %2 updates "
+		"applied in %3 chunks, %4 ms busy, %5 ms total."
+		).arg(applying->messages.size()
+		).arg(applying->updates.size()
+		).arg(applying->chunks
+		).arg(applying->busy
+		).arg(crl::now() - applying->started));
+
+	const auto replayPostponed = [&] {
+		if (!applying->postponed.empty()) {
+			DEBUG_LOG(("Updates: replaying %1 postponed updates."
+				).arg(applying->postponed.size()));
+		}
+		for (const auto &callback : applying->postponed) {
+			callback();
+		}
+	};
+	applying->result.match([&](const MTPDupdates_differenceSlice &d) {
+		auto &s = d.vintermediate_state().c_updates_state();
+		setState(s.vpts().v, s.vdate().v, s.vqts().v, s.vseq().v);
+
+		_ptsWaiter.setRequesting(false);
+		replayPostponed();
+
+		_differenceRequestedWhileApplying = false;
+		MTP_LOG(0, ("getDifference "
+			"{ good - after a slice of difference was received }%1"
+			).arg(_session->mtp().isTestMode() ? " TESTMODE" : ""));
+		getDifference();
+	}, [&](const MTPDupdates_difference &d) {
+		stateDone(d.vstate());
+		replayPostponed();
+
+		if (base::take(_differenceRequestedWhileApplying)) {
+			MTP_LOG(0, ("getDifference "
+				"{ good - requested while applying difference }%1"
+				).arg(_session->mtp().isTestMode() ? " TESTMODE" : ""));
+			getDifference();
+		}
+	}, [](const auto &) {
+		Unexpected("Difference type in Updates::finishDifference.");
+	});
+}
+
+bool Updates::postponeWhileApplyingDifference(Fn<void()> callback) {
+	if (!_differenceApplying || _differenceApplying->inChunk) {
+		return false;
+	}
+	_differenceApplying->postponed.push_back(std::move(callback));
+	return true;
 }
 
 void Updates::differenceFail(const MTP::Error &error) {
@@ -656,7 +815,10 @@ void Updates::getDifferenceAfterFail() {
 void Updates::getDifference() {
 	_getDifferenceTimeByPts = 0;
 
-	if (requestingDifference()) {
+	if (_differenceApplying) {
+		_differenceRequestedWhileApplying = true;
+		return;
+	} else if (requestingDifference()) {
 		return;
 	}
 
@@ -841,7 +1003,10 @@ void Updates::mtpUpdateReceived(const MTPUpdates &updates) {
 	_lastUpdateTime = crl::now();
 	_noUpdatesTimer.callOnce(kNoUpdatesTimeout);
 	if (!requestingDifference()
+		|| _differenceApplying
 		|| HasForceLogoutNotification(updates)) {
+		// While a received difference is applied the updates are
+		// postponed till it is finished, instead of being dropped.
 		applyUpdates(updates);
 	} else {
 		applyGroupCallParticipantUpdates(updates);
@@ -1088,6 +1253,11 @@ void Updates::handleEmojiInteraction(
 }
 
 void Updates::applyUpdatesNoPtsCheck(const MTPUpdates &updates) {
+	if (postponeWhileApplyingDifference([=] {
+		applyUpdatesNoPtsCheck(updates);
+	})) {
+		return;
+	}
 	switch (updates.type()) {
 	case mtpc_updateShortMessage: {
 		const auto &d = updates.c_updateShortMessage();
@@ -1163,6 +1333,11 @@ void Updates::applyUpdatesNoPtsCheck(const MTPUpdates &updates) {
 }
 
 void Updates::applyUpdateNoPtsCheck(const MTPUpdate &update) {
+	if (postponeWhileApplyingDifference([=] {
+		applyUpdateNoPtsCheck(update);
+	})) {
+		return;
+	}
 	switch (update.type()) {
 	case mtpc_updateNewMessage: {
 		auto &d = update.c_updateNewMessage();
@@ -1329,6 +1504,11 @@ void Updates::applyUpdateNoPtsCheck(const MTPUpdate &update) {
 void Updates::applyUpdates(
 		const MTPUpdates &updates,
 		uint64 sentMessageRandomId) {
+	if (postponeWhileApplyingDifference([=] {
+		applyUpdates(updates, sentMessageRandomId);
+	})) {
+		return;
+	}
 	const auto randomId = sentMessageRandomId;
 
 	switch (updates.type()) {
@@ -82,6 +82,19 @@ private:
 		rpl::lifetime lifetime;
 	};
 
+	struct DifferenceApplying {
+		MTPupdates_Difference result;
+		QVector<MTPMessage> messages;
+		QVector<MTPUpdate> updates;
+		std::vector<Fn<void()>> postponed;
+		int messagesApplied = 0;
+		int updatesApplied = 0;
+		int chunks = 0;
+		crl::time started = 0;
+		crl::time busy = 0;
+		bool inChunk = false;
+	};
+
 	void channelRangeDifferenceSend(
 		not_null<ChannelData*> channel,
 		MsgRange range,
@@ -105,10 +118,14 @@ private:
 	void differenceDone(const MTPupdates_Difference &result);
 	void differenceFail(const MTP::Error &error);
 	void feedDifference(
+		const MTPupdates_Difference &result,
 		const MTPVector<MTPUser> &users,
 		const MTPVector<MTPChat> &chats,
 		const MTPVector<MTPMessage> &msgs,
 		const MTPVector<MTPUpdate> &other);
+	void feedDifferenceChunk();
+	void finishDifference();
+	bool postponeWhileApplyingDifference(Fn<void()> callback);
 	void stateDone(const MTPupdates_State &state);
 	void setState(int32 pts, int32 date, int32 qts, int32 seq);
 	void channelDifferenceDone(
@@ -168,6 +185,8 @@ private:
 	base::Timer _onlineTimer;
 
 	PtsWaiter _ptsWaiter;
+	std::optional<DifferenceApplying> _differenceApplying;
+	bool _differenceRequestedWhileApplying = false;
 
 	base::flat_map<not_null<ChannelData*>, crl::time> _whenGetDiffByPts;
 	base::flat_map<not_null<ChannelData*>, crl::time> _whenGetDiffAfterFail;
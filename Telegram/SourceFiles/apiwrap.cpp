@@ -103,6 +103,7 @@ constexpr auto kSaveCloudDraftTimeout = 1000;
 constexpr auto kTopPromotionInterval = TimeId(60 * 60);
 constexpr auto kTopPromotionMinDelay = TimeId(10);
 constexpr auto kSmallDelayMs = 5;
+constexpr auto kPeersResolveLimit = 100;
 constexpr auto kReadFeaturedSetsTimeout = crl::time(1000);
 constexpr auto kFileLoaderQueueStopTimeout = crl::time(5000);
 constexpr auto kStickersByEmojiInvalidateTimeout = crl::time(6 * 1000);
@@ -144,6 +145,7 @@ ApiWrap::ApiWrap(not_null<Main::Session*> session)
 : MTP::Sender(&session->account().mtp())
 , _session(session)
 , _messageDataResolveDelayed([=] { resolveMessageDatas(); })
+, _peersResolveDelayed([=] { resolvePeers(); })
 , _webPagesTimer([=] { resolveWebPages(); })
 , _draftsSaveTimer([=] { saveDraftsToCloud(); })
 , _featuredSetsReadTimer([=] { readFeaturedSets(); })
@@ -1118,41 +1120,113 @@ void ApiWrap::gotUserFull(
 }
 
 void ApiWrap::requestPeer(not_null<PeerData*> peer) {
-	if (_fullPeerRequests.contains(peer) || _peerRequests.contains(peer)) {
+	if (_fullPeerRequests.contains(peer)
+		|| _peerRequests.contains(peer)
+		|| !_peersToResolve.emplace(peer).second) {
 		return;
 	}
+	_peersResolveDelayed.call();
+}
 
-	const auto requestId = [&] {
-		const auto failHandler = [=] {
-			_peerRequests.remove(peer);
-		};
-		const auto chatHandler = [=](const MTPmessages_Chats &result) {
+void ApiWrap::resolvePeers() {
+	if (_peersToResolve.empty()) {
+		return;
+	}
+	auto users = QVector<MTPInputUser>();
+	auto chats = QVector<MTPlong>();
+	auto channels = QVector<MTPInputChannel>();
+	auto usersPeers = std::vector<not_null<PeerData*>>();
+	auto chatsPeers = std::vector<not_null<PeerData*>>();
+	auto channelsPeers = std::vector<not_null<PeerData*>>();
+
+	// Send one users.getUsers / messages.getChats / channels.getChannels
+	// for all the peers requested in the same event loop iteration.
+	const auto finish = [=](const std::vector<not_null<PeerData*>> &peers) {
+		for (const auto peer : peers) {
 			_peerRequests.remove(peer);
-			const auto &chats = result.match([](const auto &data) {
-				return data.vchats();
-			});
-			_session->data().applyMaximumChatVersions(chats);
-			_session->data().processChats(chats);
-		};
-		if (const auto user = peer->asUser()) {
-			return request(MTPusers_GetUsers(
-				MTP_vector<MTPInputUser>(1, user->inputUser)
-			)).done([=](const MTPVector<MTPUser> &result) {
-				_peerRequests.remove(user);
-				_session->data().processUsers(result);
-			}).fail(failHandler).send();
+		}
+	};
+	const auto handleChats = [=](
+			const MTPmessages_Chats &result,
+			const std::vector<not_null<PeerData*>> &peers) {
+		finish(peers);
+		const auto &chats = result.match([](const auto &data) {
+			return data.vchats();
+		});
+		_session->data().applyMaximumChatVersions(chats);
+		_session->data().processChats(chats);
+	};
+	const auto sent = [&](
+			std::vector<not_null<PeerData*>> &peers,
+			mtpRequestId requestId) {
+		for (const auto peer : base::take(peers)) {
+			_peerRequests.emplace(peer, requestId);
+		}
+	};
+	const auto sendUsers = [&] {
+		const auto requestId = request(MTPusers_GetUsers(
+			MTP_vector<MTPInputUser>(base::take(users))
+		)).done([=, peers = usersPeers](const MTPVector<MTPUser> &result) {
+			finish(peers);
+			_session->data().processUsers(result);
+		}).fail([=, peers = usersPeers] {
+			finish(peers);
+		}).afterDelay(kSmallDelayMs).send();
+		sent(usersPeers, requestId);
+	};
+	const auto sendChats = [&] {
+		const auto requestId = request(MTPmessages_GetChats(
+			MTP_vector<MTPlong>(base::take(chats))
+		)).done([=, peers = chatsPeers](const MTPmessages_Chats &result) {
+			handleChats(result, peers);
+		}).fail([=, peers = chatsPeers] {
+			finish(peers);
+		}).afterDelay(kSmallDelayMs).send();
+		sent(chatsPeers, requestId);
+	};
+	const auto sendChannels = [&] {
+		const auto requestId = request(MTPchannels_GetChannels(
+			MTP_vector<MTPInputChannel>(base::take(channels))
+		)).done([=, peers = channelsPeers](const MTPmessages_Chats &result) {
+			handleChats(result, peers);
+		}).fail([=, peers = channelsPeers] {
+			finish(peers);
+		}).afterDelay(kSmallDelayMs).send();
+		sent(channelsPeers, requestId);
+	};
+	for (const auto peer : base::take(_peersToResolve)) {
+		if (_fullPeerRequests.contains(peer)
+			|| _peerRequests.contains(peer)) {
+			continue;
+		} else if (const auto user = peer->asUser()) {
+			users.push_back(user->inputUser);
+			usersPeers.push_back(peer);
+			if (users.size() == kPeersResolveLimit) {
+				sendUsers();
+			}
 		} else if (const auto chat = peer->asChat()) {
-			return request(MTPmessages_GetChats(
-				MTP_vector<MTPlong>(1, chat->inputChat)
-			)).done(chatHandler).fail(failHandler).send();
+			chats.push_back(chat->inputChat);
+			chatsPeers.push_back(peer);
+			if (chats.size() == kPeersResolveLimit) {
+				sendChats();
+			}
 		} else if (const auto channel = peer->asChannel()) {
-			return request(MTPchannels_GetChannels(
-				MTP_vector<MTPInputChannel>(1, channel->inputChannel)
-			)).done(chatHandler).fail(failHandler).send();
+			channels.push_back(channel->inputChannel);
+			channelsPeers.push_back(peer);
+			if (channels.size() == kPeersResolveLimit) {
+				sendChannels();
+			}
 		}
-		Unexpected("Peer type in requestPeer.");
-	}();
-	_peerRequests.emplace(peer, requestId);
+	}
+	if (!users.isEmpty()) {
+		sendUsers();
+	}
+	if (!chats.isEmpty()) {
+		sendChats();
+	}
+	if (!channels.isEmpty()) {
+		sendChannels();
+	}
 }
 
 void ApiWrap::requestPeerSettings(not_null<PeerData*> peer) {
@@ -1312,48 +1386,11 @@ void ApiWrap::markContentsRead(not_null<HistoryItem*> item) {
 }
 
 void ApiWrap::requestPeers(const QList<PeerData*> &peers) {
-	QVector<MTPlong> chats;
-	QVector<MTPInputChannel> channels;
-	QVector<MTPInputUser> users;
-	chats.reserve(peers.size());
-	channels.reserve(peers.size());
-	users.reserve(peers.size());
 	for (const auto peer : peers) {
-		if (!peer
-			|| _fullPeerRequests.contains(peer)
-			|| _peerRequests.contains(peer)) {
-			continue;
-		}
-		if (const auto user = peer->asUser()) {
-			users.push_back(user->inputUser);
-		} else if (const auto chat = peer->asChat()) {
-			chats.push_back(chat->inputChat);
-		} else if (const auto channel = peer->asChannel()) {
-			channels.push_back(channel->inputChannel);
+		if (peer) {
+			requestPeer(peer);
 		}
 	}
-	const auto handleChats = [=](const MTPmessages_Chats &result) {
-		_session->data().processChats(result.match([](const auto &data) {
-			return data.vchats();
-		}));
-	};
-	if (!chats.isEmpty()) {
-		request(MTPmessages_GetChats(
-			MTP_vector<MTPlong>(chats)
-		)).done(handleChats).send();
-	}
-	if (!channels.isEmpty()) {
-		request(MTPchannels_GetChannels(
-			MTP_vector<MTPInputChannel>(channels)
-		)).done(handleChats).send();
-	}
-	if (!users.isEmpty()) {
-		request(MTPusers_GetUsers(
-			MTP_vector<MTPInputUser>(users)
-		)).done([=](const MTPVector<MTPUser> &result) {
-			_session->data().processUsers(result);
-		}).send();
-	}
 }
 
 void ApiWrap::deleteAllFromParticipant(
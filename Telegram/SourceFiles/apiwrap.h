@@ -410,6 +410,7 @@ private:
 	void saveDraftsToCloud();
 
 	void resolveMessageDatas();
+	void resolvePeers();
 	void finalizeMessageDataRequest(
 		ChannelData *channel,
 		mtpRequestId requestId);
@@ -523,6 +524,8 @@ private:
 	using PeerRequests = base::flat_map<PeerData*, mtpRequestId>;
 	PeerRequests _fullPeerRequests;
 	PeerRequests _peerRequests;
+	base::flat_set<not_null<PeerData*>> _peersToResolve;
+	SingleQueuedInvokation _peersResolveDelayed;
 	base::flat_set<not_null<PeerData*>> _requestedPeerSettings;
 
 	base::flat_map<
@@ -973,6 +973,7 @@ void PeerListContent::addToSearchIndex(not_null<PeerListRow*> row) {
 	for (auto ch : row->nameFirstLetters()) {
 		_searchIndex[ch].push_back(row);
 	}
+	searchIndexChanged();
 }
 
 void PeerListContent::removeFromSearchIndex(not_null<PeerListRow*> row) {
@@ -989,9 +990,15 @@ void PeerListContent::removeFromSearchIndex(not_null<PeerListRow*> row) {
 			}
 		}
 		row->setNameFirstLetters({});
+		searchIndexChanged();
 	}
 }
 
+void PeerListContent::searchIndexChanged() {
+	_localSearchWords.clear();
+	_localSearchResults.clear();
+}
+
 void PeerListContent::prependRow(std::unique_ptr<PeerListRow> row) {
 	Expects(row != nullptr);
 
@@ -1091,6 +1098,7 @@ void PeerListContent::clearAllContent() {
 	_rowsByPeer.clear();
 	_filterResults.clear();
 	_searchIndex.clear();
+	searchIndexChanged();
 	_rows.clear();
 	_searchRows.clear();
 	_searchQuery
@@ -1764,16 +1772,36 @@ void PeerListContent::searchQueryChanged(QString query) {
 		if (_controller->searchInLocal() && !searchWordsList.isEmpty()) {
 			Assert(_hiddenRows.empty());
 
+			// When the query only extends the previous one (while typing)
+			// the previous results already contain all the new ones.
+			const auto refinesLocalSearch = [&] {
+				const auto count = _localSearchWords.size();
+				if (!count || searchWordsList.size() < count) {
+					return false;
+				}
+				for (auto i = 0; i != count; ++i) {
+					if (!searchWordsList[i].startsWith(_localSearchWords[i])) {
+						return false;
+					}
+				}
+				return true;
+			}();
+
 			auto minimalList = (const std::vector<not_null<PeerListRow*>>*)nullptr;
-			for (const auto &searchWord : searchWordsList) {
-				auto searchWordStart = searchWord[0].toLower();
-				auto it = _searchIndex.find(searchWordStart);
-				if (it == _searchIndex.cend()) {
-					// Some word can't be found in any row.
-					minimalList = nullptr;
-					break;
-				} else if (!minimalList || minimalList->size() > it->second.size()) {
-					minimalList = &it->second;
+			if (refinesLocalSearch) {
+				minimalList = &_localSearchResults;
+			} else {
+				for (const auto &searchWord : searchWordsList) {
+					auto searchWordStart = searchWord[0].toLower();
+					auto it = _searchIndex.find(searchWordStart);
+					if (it == _searchIndex.cend()) {
+						// Some word can't be found in any row.
+						minimalList = nullptr;
+						break;
+					} else if (!minimalList
+						|| minimalList->size() > it->second.size()) {
+						minimalList = &it->second;
+					}
 				}
 			}
 			if (minimalList) {
@@ -1804,6 +1832,8 @@ void PeerListContent::searchQueryChanged(QString query) {
 					}
 				}
 			}
+			_localSearchWords = searchWordsList;
+			_localSearchResults = _filterResults;
 		}
 		if (_controller->hasComplexSearch()) {
 			_controller->search(_searchQuery);
@@ -629,6 +629,7 @@ public:
 		for (auto &searchEntity : _searchIndex) {
 			callback(searchEntity.second.begin(), searchEntity.second.end());
 		}
+		searchIndexChanged();
 		refreshIndices();
 		if (!_hiddenRows.empty()) {
 			callback(_filterResults.begin(), _filterResults.end());
@@ -750,6 +751,7 @@ private:
 	void addToSearchIndex(not_null<PeerListRow*> row);
 	bool addingToSearchIndex() const;
 	void removeFromSearchIndex(not_null<PeerListRow*> row);
+	void searchIndexChanged();
 	void setSearchQuery(const QString &query, const QString &normalizedQuery);
 	bool showingSearch() const {
 		return !_hiddenRows.empty() || !_searchQuery.isEmpty();
@@ -794,6 +796,8 @@ private:
 	std::map<PeerData*, std::vector<not_null<PeerListRow*>>> _rowsByPeer;
 
 	std::map<QChar, std::vector<not_null<PeerListRow*>>> _searchIndex;
+	QStringList _localSearchWords;
+	std::vector<not_null<PeerListRow*>> _localSearchResults;
 	QString _searchQuery;
 	QString _normalizedSearchQuery;
 	QString _mentionHighlight;
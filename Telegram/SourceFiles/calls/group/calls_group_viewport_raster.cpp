@@ -22,6 +22,7 @@ namespace Calls::Group {
 namespace {
 
 constexpr auto kBlurRadius = 15;
+constexpr auto kConvertTimeLogFrames = 300;
 
 } // namespace
 
@@ -47,6 +48,7 @@ void Viewport::RendererSW::paintFallback(
 	}
 	for (const auto &tile : _owner->_tiles) {
 		if (!tile->visible()) {
+			tile->track()->setScaleHint(QSize());
 			continue;
 		}
 		paintTile(p, tile.get(), bounding, bg);
@@ -74,7 +76,9 @@ void Viewport::RendererSW::validateUserpicFrame(
 	} else if (!data.userpicFrame.isNull()) {
 		return;
 	}
-	const auto size = tile->trackOrUserpicSize();
+	// The blurred userpic is scaled up when painted anyway,
+	// so there is no need to blur it in the full track size.
+	const auto size = VideoTile::PausedVideoSize();
 	data.userpicFrame = Images::BlurLargeImage(
 		tile->row()->peer()->generateUserpicImage(
 			tile->row()->ensureUserpicView(),
@@ -83,6 +87,31 @@ void Viewport::RendererSW::validateUserpicFrame(
 		kBlurRadius);
 }
 
+void Viewport::RendererSW::accumulateConvertTime(
+		not_null<VideoTile*> tile,
+		TileData &data,
+		const Webrtc::FrameWithInfo &frame) {
+	if (frame.format != Webrtc::FrameFormat::ARGB32
+		|| frame.index == data.lastFrameIndex) {
+		return;
+	}
+	data.lastFrameIndex = frame.index;
+	data.convertTime += frame.convertTime;
+	if (++data.convertFrames < kConvertTimeLogFrames) {
+		return;
+	}
+	DEBUG_LOG(("Calls Info: Tile %1 converted %2x%3 frames "
+		"to %4x%5 in %6 mcs avg."
+		).arg(QString::fromStdString(tile->endpoint().id)
+		).arg(frame.yuv420->size.width()
+		).arg(frame.yuv420->size.height()
+		).arg(frame.original.width()
+		).arg(frame.original.height()
+		).arg(data.convertTime / data.convertFrames));
+	data.convertTime = 0;
+	data.convertFrames = 0;
+}
+
 void Viewport::RendererSW::paintTile(
 		Painter &p,
 		not_null<VideoTile*> tile,
@@ -92,9 +121,14 @@ void Viewport::RendererSW::paintTile(
 	const auto markGuard = gsl::finally([&] {
 		tile->track()->markFrameShown();
 	});
+
+	// Let the decoding thread convert straight into the tile size.
+	track->setScaleHint(tile->geometry().size() * style::DevicePixelRatio());
+
 	const auto data = track->frameWithInfo(true);
 	auto &tileData = _tileData[tile];
 	tileData.stale = false;
+	accumulateConvertTime(tile, tileData, data);
 	_userpicFrame = (data.format == Webrtc::FrameFormat::None);
 	_pausedFrame = (track->state() == Webrtc::VideoState::Paused);
 	validateUserpicFrame(tile, tileData);
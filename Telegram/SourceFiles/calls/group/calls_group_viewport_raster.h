@@ -13,6 +13,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/gl/gl_surface.h"
 #include "ui/text/text.h"
 
+namespace Webrtc {
+struct FrameWithInfo;
+} // namespace Webrtc
+
 namespace Calls::Group {
 
 class Viewport::RendererSW final : public Ui::GL::Renderer {
@@ -28,6 +32,9 @@ private:
 	struct TileData {
 		QImage userpicFrame;
 		QImage blurredFrame;
+		crl::profile_time convertTime = 0;
+		int convertFrames = 0;
+		int lastFrameIndex = -1;
 		bool stale = false;
 	};
 	void paintTile(
@@ -52,6 +59,10 @@ private:
 	void validateUserpicFrame(
 		not_null<VideoTile*> tile,
 		TileData &data);
+	void accumulateConvertTime(
+		not_null<VideoTile*> tile,
+		TileData &data,
+		const Webrtc::FrameWithInfo &frame);
 
 	const not_null<Viewport*> _owner;
 
@@ -1807,7 +1807,13 @@ void StickersListWidget::paintEvent(QPaintEvent *e) {
 	auto clip = e->rect();
 	p.fillRect(clip, st::emojiPanBg);
 
+	_animationsSetupDelayed = false;
 	paintStickers(p, clip);
+	if (_animationsSetupDelayed) {
+		// Some visible stickers were painted from their static frames
+		// while scrolling, repaint them with animations once it settles.
+		updateItems();
+	}
 }
 
 void StickersListWidget::paintStickers(Painter &p, QRect clip) {
@@ -1986,6 +1992,9 @@ void StickersListWidget::checkVisibleLottie() {
 		if (destroyBelow <= info.rowsTop
 			|| destroyAbove >= info.rowsBottom) {
 			clearHeavyIn(shownSets()[info.section]);
+		} else if (visibleBottom <= info.rowsTop
+			|| visibleTop >= info.rowsBottom) {
+			pauseAllLottieIn(shownSets()[info.section]);
 		} else if ((visibleTop > info.rowsTop && visibleTop < info.rowsBottom)
 			|| (visibleBottom > info.rowsTop
 				&& visibleBottom < info.rowsBottom)) {
@@ -1995,6 +2004,18 @@ void StickersListWidget::checkVisibleLottie() {
 	});
 }
 
+void StickersListWidget::pauseAllLottieIn(Set &set) {
+	const auto player = set.lottiePlayer.get();
+	if (!player) {
+		return;
+	}
+	for (const auto &sticker : set.stickers) {
+		if (const auto animated = sticker.lottie) {
+			player->pause(animated);
+		}
+	}
+}
+
 void StickersListWidget::clearHeavyIn(Set &set, bool clearSavedFrames) {
 	const auto player = base::take(set.lottiePlayer);
 	const auto lifetime = base::take(set.lottieLifetime);
@@ -2298,11 +2319,15 @@ void StickersListWidget::paintSticker(
 	const auto locked = document->isPremiumSticker() && !session().premium();
 	const auto isLottie = document->sticker()->isLottie();
 	const auto isWebm = document->sticker()->isWebm();
-	if (isLottie
-		&& !sticker.lottie
-		&& media->loaded()) {
+	const auto setupAnimation = media->loaded()
+		&& ((isLottie && !sticker.lottie) || (isWebm && !sticker.webm));
+	if (setupAnimation && (now < _lastScrolledAt + kMinAfterScrollDelay)) {
+		// Don't start decoding new animations during a scroll,
+		// the static frame is painted instead until it stops.
+		_animationsSetupDelayed = true;
+	} else if (setupAnimation && isLottie) {
 		setupLottie(set, section, index);
-	} else if (isWebm && !sticker.webm && media->loaded()) {
+	} else if (setupAnimation) {
 		setupWebm(set, section, index);
 	}
 
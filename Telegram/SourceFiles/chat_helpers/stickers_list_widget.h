@@ -275,6 +275,7 @@ private:
 	void markLottieFrameShown(Set &set);
 	void checkVisibleLottie();
 	void pauseInvisibleLottieIn(const SectionInfo &info);
+	void pauseAllLottieIn(Set &set);
 	void takeHeavyData(std::vector<Set> &to, std::vector<Set> &from);
 	void takeHeavyData(Set &to, Set &from);
 	void takeHeavyData(Sticker &to, Sticker &from);
@@ -356,6 +357,7 @@ private:
 
 	crl::time _lastScrolledAt = 0;
 	crl::time _lastFullUpdatedAt = 0;
+	bool _animationsSetupDelayed = false;
 
 	mtpRequestId _officialRequestId = 0;
 	int _officialOffset = 0;
@@ -51,6 +51,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/file_utilities.h"
 #include "core/click_handler_types.h" // ClickHandlerContext.
 #include "core/crash_reports.h"
+#include "core/startup_trace.h"
 #include "main/main_account.h"
 #include "main/main_domain.h"
 #include "main/main_session.h"
@@ -176,6 +177,8 @@ Application::Application(not_null<Launcher*> launcher)
 }
 
 Application::~Application() {
+	StartupTrace::Finish();
+
 	if (_saveSettingsTimer && _saveSettingsTimer->isActive()) {
 		Local::writeSettings();
 	}
@@ -220,6 +223,8 @@ Application::~Application() {
 }
 
 void Application::run() {
+	const auto span = StartupTrace::Span("Application::run");
+
 	style::internal::StartFonts();
 
 	ThirdParty::start();
@@ -269,6 +274,7 @@ void Application::run() {
 	}, _lifetime);
 
 	DEBUG_LOG(("Application Info: inited..."));
+	StartupTrace::Mark("Application inited");
 
 	cChangeDateFormat(QLocale::system().dateFormat(QLocale::ShortFormat));
 	cChangeTimeFormat(QLocale::system().timeFormat(QLocale::ShortFormat));
@@ -278,7 +284,10 @@ void Application::run() {
 	// Create mime database, so it won't be slow later.
 	QMimeDatabase().mimeTypeForName(qsl("text/plain"));
 
-	_primaryWindow = std::make_unique<Window::Controller>();
+	{
+		const auto span = StartupTrace::Span("Window::Controller");
+		_primaryWindow = std::make_unique<Window::Controller>();
+	}
 	_lastActiveWindow = _primaryWindow.get();
 
 	_domain->activeChanges(
@@ -331,9 +340,13 @@ void Application::run() {
 	startTray();
 
 	_primaryWindow->widget()->show();
+	StartupTrace::Mark("Main window shown");
 
 	const auto currentGeometry = _primaryWindow->widget()->geometry();
-	_mediaView = std::make_unique<Media::View::OverlayWidget>();
+	{
+		const auto span = StartupTrace::Span("Media::View::OverlayWidget");
+		_mediaView = std::make_unique<Media::View::OverlayWidget>();
+	}
 	_primaryWindow->widget()->Ui::RpWidget::setGeometry(currentGeometry);
 
 	DEBUG_LOG(("Application Info: showing."));
@@ -645,6 +658,7 @@ void Application::badMtprotoConfigurationError() {
 }
 
 void Application::startLocalStorage() {
+	const auto span = StartupTrace::Span("Local::start");
 	Local::start();
 	_saveSettingsTimer.emplace([=] { saveSettings(); });
 	settings().saveDelayedRequests() | rpl::start_with_next([=] {
@@ -657,6 +671,7 @@ void Application::startEmojiImageLoader() {
 		source = prepareEmojiSourceImages(),
 		large = settings().largeEmoji()
 	](Stickers::EmojiImageLoader &loader) mutable {
+		const auto span = StartupTrace::Span("EmojiImageLoader::init");
 		loader.init(std::move(source), large);
 	});
 
@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/crash_reports.h"
 #include "core/update_checker.h"
 #include "core/sandbox.h"
+#include "core/startup_trace.h"
 #include "base/concurrent_timer.h"
 #include "base/options.h"
 
@@ -311,7 +312,11 @@ void Launcher::init() {
 }
 
 int Launcher::exec() {
-	init();
+	StartupTrace::Start();
+	{
+		const auto span = StartupTrace::Span("Launcher::init");
+		init();
+	}
 
 	if (cLaunchMode() == LaunchModeFixPrevious) {
 		return psFixPrevious();
@@ -319,6 +324,8 @@ int Launcher::exec() {
 		return psCleanup();
 	}
 
+	StartupTrace::Mark("Launcher inited");
+
 	// Must be started before Platform is started.
 	Logs::start(this);
 	base::options::init(cWorkingDir() + "tdata/experimental_options.json");
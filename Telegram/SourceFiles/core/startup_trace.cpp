@@ -0,0 +1,157 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/startup_trace.h"
+
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+
+#include <atomic>
+
+namespace Core::StartupTrace {
+namespace {
+
+struct Event {
+	const char *name = nullptr;
+	crl::profile_time start = 0;
+	crl::profile_time duration = -1;
+	int thread = 0;
+};
+
+struct State {
+	QMutex mutex;
+	QString path;
+	crl::profile_time started = 0;
+	std::vector<Event> events;
+	base::flat_map<Qt::HANDLE, int> threads;
+};
+
+std::atomic<bool> Active/* = false*/;
+
+[[nodiscard]] State &GetState() {
+	static auto result = State();
+	return result;
+}
+
+[[nodiscard]] int ThreadIndex(State &state) {
+	const auto handle = QThread::currentThreadId();
+	const auto i = state.threads.find(handle);
+	if (i != end(state.threads)) {
+		return i->second;
+	}
+	const auto result = int(state.threads.size()) + 1;
+	state.threads.emplace(handle, result);
+	return result;
+}
+
+void AddEvent(
+		const char *name,
+		crl::profile_time start,
+		crl::profile_time duration) {
+	if (!Active) {
+		return;
+	}
+	auto &state = GetState();
+	QMutexLocker lock(&state.mutex);
+	state.events.push_back({
+		.name = name,
+		.start = start - state.started,
+		.duration = duration,
+		.thread = ThreadIndex(state),
+	});
+}
+
+[[nodiscard]] QByteArray Serialize(const State &state) {
+	auto result = QByteArray("{\"traceEvents\":[\n");
+	auto first = true;
+	const auto add = [&](const QByteArray &event) {
+		if (!first) {
+			result.append(",\n");
+		}
+		first = false;
+		result.append(event);
+	};
+	for (const auto &[handle, index] : state.threads) {
+		const auto name = (index == 1)
+			? QByteArray("main")
+			: ("thread " + QByteArray::number(index));
+		add("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+			+ QByteArray::number(index)
+			+ ",\"args\":{\"name\":\"" + name + "\"}}");
+	}
+	for (const auto &event : state.events) {
+		const auto common = "\"name\":\"" + QByteArray(event.name)
+			+ "\",\"pid\":1,\"tid\":" + QByteArray::number(event.thread)
+			+ ",\"ts\":" + QByteArray::number(event.start);
+		add((event.duration >= 0)
+			? ("{" + common
+				+ ",\"ph\":\"X\",\"dur\":"
+				+ QByteArray::number(event.duration)
+				+ "}")
+			: ("{" + common + ",\"ph\":\"i\",\"s\":\"p\"}"));
+	}
+	result.append("\n]}\n");
+	return result;
+}
+
+} // namespace
+
+void Start() {
+	const auto path = qEnvironmentVariable("TDESKTOP_STARTUP_TRACE");
+	if (path.isEmpty() || Active) {
+		return;
+	}
+	auto &state = GetState();
+	{
+		QMutexLocker lock(&state.mutex);
+		state.path = path;
+		state.started = crl::profile();
+		state.events.reserve(256);
+		ThreadIndex(state);
+	}
+	Active = true;
+}
+
+bool Enabled() {
+	return Active;
+}
+
+void Mark(const char *name) {
+	AddEvent(name, crl::profile(), -1);
+}
+
+void Finish() {
+	if (!Active.exchange(false)) {
+		return;
+	}
+	auto &state = GetState();
+	QMutexLocker lock(&state.mutex);
+	auto f = QFile(state.path);
+	if (f.open(QIODevice::WriteOnly)) {
+		f.write(Serialize(state));
+		LOG(("Startup Trace: %1 events written to '%2'."
+			).arg(state.events.size()
+			).arg(state.path));
+	} else {
+		LOG(("Startup Trace Error: Could not open '%1'.").arg(state.path));
+	}
+	base::take(state.events);
+}
+
+Span::Span(const char *name)
+: _name(Active ? name : nullptr)
+, _start(_name ? crl::profile() : 0) {
+}
+
+Span::~Span() {
+	if (_name) {
+		const auto now = crl::profile();
+		AddEvent(_name, _start, now - _start);
+	}
+}
+
+} // namespace Core::StartupTrace
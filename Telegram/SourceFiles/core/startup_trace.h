@@ -0,0 +1,33 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Core::StartupTrace {
+
+// Enabled by TDESKTOP_STARTUP_TRACE environment variable with a path
+// of a Chrome trace file, written when the chats list is first painted.
+void Start();
+[[nodiscard]] bool Enabled();
+
+void Mark(const char *name);
+void Finish();
+
+class Span final {
+public:
+	explicit Span(const char *name);
+	Span(const Span &other) = delete;
+	Span &operator=(const Span &other) = delete;
+	~Span();
+
+private:
+	const char *_name = nullptr;
+	crl::profile_time _start = 0;
+
+};
+
+} // namespace Core::StartupTrace
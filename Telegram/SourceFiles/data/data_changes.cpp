@@ -11,6 +11,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Data {
 
+template <typename DataType, typename UpdateType>
+Changes::Manager<DataType, UpdateType>::~Manager() {
+	// Destroying keyed streams ends their subscriptions,
+	// those shouldn't try to update the streams being destroyed.
+	invalidate_weak_ptrs(this);
+}
+
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::updated(
 		not_null<DataType*> data,
@@ -23,7 +30,7 @@ void Changes::Manager<DataType, UpdateType>::updated(
 			flags |= i->second;
 			_updates.erase(i);
 		}
-		_stream.fire({ data, flags });
+		fire(data, flags);
 	} else {
 		_updates[data] |= flags;
 	}
@@ -54,11 +61,73 @@ template <typename DataType, typename UpdateType>
 rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::updates(
 		not_null<DataType*> data,
 		Flags flags) const {
-	return _stream.events(
-	) | rpl::filter([=](const UpdateType &update) {
-		const auto [updateData, updateFlags] = update;
-		return (updateData == data) && (updateFlags & flags);
-	});
+	return [=](auto consumer) {
+		auto &keyed = _keyedStreams[data.get()];
+		++keyed.subscribers;
+
+		const auto skipFire = (_globalFiring == data.get())
+			? _globalFireId
+			: 0;
+		auto result = (keyed.stream.events(
+		) | rpl::filter([=](const UpdateType &update) {
+			return (update.flags & flags) && (_keyedFireId != skipFire);
+		})).start_existing(consumer);
+		result.add([=, weak = base::make_weak(this)] {
+			if (weak) {
+				unsubscribed(data);
+			}
+		});
+		return result;
+	};
+}
+
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::unsubscribed(
+		not_null<DataType*> data) const {
+	const auto i = _keyedStreams.find(data.get());
+	Assert(i != end(_keyedStreams));
+	if (!--i->second.subscribers) {
+		++_unusedKeyedStreams;
+	}
+}
+
+template <typename DataType, typename UpdateType>
+bool Changes::Manager<DataType, UpdateType>::fire(
+		not_null<DataType*> data,
+		Flags flags) {
+	++_firing;
+	const auto fireId = ++_fireIdLast;
+	const auto wasGlobal = std::exchange(_globalFiring, data.get());
+	const auto wasGlobalId = std::exchange(_globalFireId, fireId);
+	_stream.fire({ data, flags });
+	_globalFiring = wasGlobal;
+	_globalFireId = wasGlobalId;
+
+	const auto i = _keyedStreams.find(data.get());
+	const auto keyed = (i != end(_keyedStreams))
+		&& (i->second.subscribers > 0);
+	if (keyed) {
+		const auto wasKeyedId = std::exchange(_keyedFireId, fireId);
+		i->second.stream.fire({ data, flags });
+		_keyedFireId = wasKeyedId;
+	}
+	if (!--_firing && _unusedKeyedStreams) {
+		removeUnusedKeyedStreams();
+	}
+	return keyed;
+}
+
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::removeUnusedKeyedStreams() {
+	// Streams are removed only when none of them is being fired.
+	_unusedKeyedStreams = 0;
+	for (auto i = begin(_keyedStreams); i != end(_keyedStreams);) {
+		if (i->second.subscribers > 0) {
+			++i;
+		} else {
+			i = _keyedStreams.erase(i);
+		}
+	}
 }
 
 template <typename DataType, typename UpdateType>
@@ -77,15 +146,23 @@ rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::flagsValue(
 }
 
 template <typename DataType, typename UpdateType>
-void Changes::Manager<DataType, UpdateType>::sendNotifications() {
+auto Changes::Manager<DataType, UpdateType>::sendNotifications()
+-> Delivered {
+	auto result = Delivered();
 	for (const auto &[data, flags] : base::take(_updates)) {
-		_stream.fire({ data, flags });
+		++result.updates;
+		if (fire(data, flags)) {
+			++result.keyed;
+		}
 	}
+	return result;
 }
 
 Changes::Changes(not_null<Main::Session*> session) : _session(session) {
 }
 
+Changes::~Changes() = default;
+
 Main::Session &Changes::session() const {
 	return *_session;
 }
@@ -238,10 +315,27 @@ void Changes::sendNotifications() {
 		return;
 	}
 	_notify = false;
-	_peerChanges.sendNotifications();
-	_historyChanges.sendNotifications();
-	_messageChanges.sendNotifications();
-	_entryChanges.sendNotifications();
+	const auto peers = _peerChanges.sendNotifications();
+	const auto histories = _historyChanges.sendNotifications();
+	const auto messages = _messageChanges.sendNotifications();
+	const auto entries = _entryChanges.sendNotifications();
+	if (!peers.keyed
+		&& !histories.keyed
+		&& !messages.keyed
+		&& !entries.keyed) {
+		return;
+	}
+	DEBUG_LOG(("Changes Info: Sent updates (keyed) - "
+		"peers: %1 (%2), histories: %3 (%4), "
+		"messages: %5 (%6), entries: %7 (%8)."
+		).arg(peers.updates
+		).arg(peers.keyed
+		).arg(histories.updates
+		).arg(histories.keyed
+		).arg(messages.updates
+		).arg(messages.keyed
+		).arg(entries.updates
+		).arg(entries.keyed));
 }
 
 } // namespace Data
@@ -8,6 +8,9 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "base/flags.h"
+#include "base/weak_ptr.h"
+
+#include <unordered_map>
 
 class History;
 class PeerData;
@@ -182,6 +185,7 @@ struct EntryUpdate {
 class Changes final {
 public:
 	explicit Changes(not_null<Main::Session*> session);
+	~Changes();
 
 	[[nodiscard]] Main::Session &session() const;
 
@@ -250,11 +254,13 @@ public:
 
 private:
 	template <typename DataType, typename UpdateType>
-	class Manager final {
+	class Manager final : public base::has_weak_ptr {
 	public:
 		using Flag = typename UpdateType::Flag;
 		using Flags = typename UpdateType::Flags;
 
+		~Manager();
+
 		void updated(
 			not_null<DataType*> data,
 			Flags flags,
@@ -269,19 +275,45 @@ private:
 		[[nodiscard]] rpl::producer<UpdateType> realtimeUpdates(
 			Flag flag) const;
 
-		void sendNotifications();
+		struct Delivered {
+			int updates = 0;
+			int keyed = 0;
+		};
+		Delivered sendNotifications();
 
 	private:
 		static constexpr auto kCount = details::CountBit<Flag>() + 1;
 
+		struct KeyedStream {
+			rpl::event_stream<UpdateType> stream;
+			int subscribers = 0;
+		};
+
 		void sendRealtimeNotifications(
 			not_null<DataType*> data,
 			Flags flags);
+		bool fire(not_null<DataType*> data, Flags flags);
+		void unsubscribed(not_null<DataType*> data) const;
+		void removeUnusedKeyedStreams();
 
 		std::array<rpl::event_stream<UpdateType>, kCount> _realtimeStreams;
 		base::flat_map<not_null<DataType*>, Flags> _updates;
 		rpl::event_stream<UpdateType> _stream;
 
+		// Subscriptions to a single object don't need to filter
+		// the updates of all the other objects. Such subscribers get
+		// each update after all the subscribers of updates(flags).
+		mutable std::unordered_map<DataType*, KeyedStream> _keyedStreams;
+		mutable int _unusedKeyedStreams = 0;
+		int _firing = 0;
+
+		// Keyed subscribers added while an update is fired to all
+		// the subscribers of updates(flags) skip it in the keyed fire.
+		uint64 _fireIdLast = 0;
+		uint64 _globalFireId = 0;
+		uint64 _keyedFireId = 0;
+		DataType *_globalFiring = nullptr;
+
 	};
 
 	void scheduleNotifications();
@@ -428,7 +428,10 @@ void DocumentMedia::GenerateGoodThumbnail(
 		return;
 	}
 	const auto guard = base::make_weak(&document->owner().session());
-	crl::async([=, location = std::move(location)] {
+	crl::async(crl::priority::background, [
+		=,
+		location = std::move(location)
+	] {
 		const auto filepath = (location && location->accessEnable())
 			? location->name()
 			: QString();
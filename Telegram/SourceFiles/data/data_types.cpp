@@ -21,6 +21,7 @@ constexpr auto kDocumentThumbCacheMask = 0x00000000000000FFULL;
 constexpr auto kWebDocumentCacheTag = 0x0000020000000000ULL;
 constexpr auto kUrlCacheTag = 0x0000030000000000ULL;
 constexpr auto kGeoPointCacheTag = 0x0000040000000000ULL;
+constexpr auto kUploadStateCacheTag = 0x0000050000000000ULL;
 
 } // namespace
 
@@ -86,6 +87,25 @@ Storage::Cache::Key GeoPointCacheKey(const GeoPointLocation &location) {
 	};
 }
 
+Storage::Cache::Key UploadStateCacheKey(
+		const QString &filepath,
+		int64 size,
+		const QDateTime &modified) {
+	const auto full = filepath.toUtf8()
+		+ '\n' + QByteArray::number(size)
+		+ '\n' + QByteArray::number(modified.toMSecsSinceEpoch());
+	const auto hash = openssl::Sha256(bytes::make_span(full));
+	const auto bytes = bytes::make_span(hash);
+	const auto bytes1 = bytes.subspan(0, sizeof(uint32));
+	const auto bytes2 = bytes.subspan(sizeof(uint32), sizeof(uint64));
+	const auto part1 = *reinterpret_cast<const uint32*>(bytes1.data());
+	const auto part2 = *reinterpret_cast<const uint64*>(bytes2.data());
+	return Storage::Cache::Key{
+		Data::kUploadStateCacheTag | part1,
+		part2
+	};
+}
+
 } // namespace Data
 
 void MessageCursor::fillFrom(not_null<const Ui::InputField*> field) {
@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_item.h"
 #include "core/shortcuts.h"
 #include "core/application.h"
+#include "core/startup_trace.h"
 #include "ui/widgets/buttons.h"
 #include "ui/widgets/popup_menu.h"
 #include "ui/text/text_utilities.h"
@@ -404,6 +405,11 @@ void InnerWidget::changeOpenedFolder(Data::Folder *folder) {
 }
 
 void InnerWidget::paintEvent(QPaintEvent *e) {
+	const auto span = Core::StartupTrace::Span("Chats list paint");
+	if (Core::StartupTrace::Enabled()) {
+		// Write the trace right after the first chats list paint.
+		crl::on_main(this, Core::StartupTrace::Finish);
+	}
 	Painter p(this);
 
 	const auto r = e->rect();
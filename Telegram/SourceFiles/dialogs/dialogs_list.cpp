@@ -13,6 +13,36 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mainwidget.h"
 
 namespace Dialogs {
+namespace {
+
+// Returns the first row for which the predicate is false.
+template <typename Iterator, typename Predicate>
+[[nodiscard]] Iterator FindFirstNot(
+		Iterator from,
+		Iterator till,
+		bool sorted,
+		Predicate &&predicate) {
+	return sorted
+		? std::partition_point(from, till, predicate)
+		: std::find_if_not(from, till, predicate);
+}
+
+// Returns the row after the last one for which the predicate is true.
+template <typename Iterator, typename Predicate>
+[[nodiscard]] Iterator FindAfterLast(
+		Iterator from,
+		Iterator till,
+		bool sorted,
+		Predicate &&predicate) {
+	return sorted
+		? std::partition_point(from, till, predicate)
+		: std::find_if(
+			std::make_reverse_iterator(till),
+			std::make_reverse_iterator(from),
+			predicate).base();
+}
+
+} // namespace
 
 List::List(SortMode sortMode, FilterId filterId)
 : _sortMode(sortMode)
@@ -62,19 +92,26 @@ not_null<Row*> List::addByName(Key key) {
 void List::adjustByName(not_null<Row*> row) {
 	Expects(row->pos() >= 0 && row->pos() < _rows.size());
 
+	// All rows except the adjusted one are sorted,
+	// so the new place may be found by a binary search.
 	const auto &key = row->entry()->chatListNameSortKey();
 	const auto index = row->pos();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return row->entry()->chatListNameSortKey().compare(key) >= 0;
+	const auto sorted = (i == _rows.begin())
+		|| (i + 1 == _rows.end())
+		|| ((*(i - 1))->entry()->chatListNameSortKey().compare(
+			(*(i + 1))->entry()->chatListNameSortKey()) <= 0);
+	const auto before = FindFirstNot(i + 1, _rows.end(), sorted, [&](
+			Row *row) {
+		return row->entry()->chatListNameSortKey().compare(key) < 0;
 	});
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
 	} else if (i != _rows.begin()) {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
+		const auto after = FindAfterLast(_rows.begin(), i, sorted, [&](
+				Row *row) {
 			return row->entry()->chatListNameSortKey().compare(key) <= 0;
-		}).base();
+		});
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
@@ -84,19 +121,27 @@ void List::adjustByName(not_null<Row*> row) {
 void List::adjustByDate(not_null<Row*> row) {
 	Expects(_sortMode == SortMode::Date);
 
+	// All rows except the adjusted one are sorted, so the new place may
+	// be found by a binary search. While a pinned list is applied rows
+	// are moved one by one, if the neighbours show that, scan linearly.
 	const auto key = row->sortKey(_filterId);
 	const auto index = row->pos();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return (row->sortKey(_filterId) <= key);
+	const auto sorted = (i == _rows.begin())
+		|| (i + 1 == _rows.end())
+		|| ((*(i - 1))->sortKey(_filterId)
+			>= (*(i + 1))->sortKey(_filterId));
+	const auto before = FindFirstNot(i + 1, _rows.end(), sorted, [&](
+			Row *row) {
+		return (row->sortKey(_filterId) > key);
 	});
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
 	} else {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
+		const auto after = FindAfterLast(_rows.begin(), i, sorted, [&](
+				Row *row) {
 			return (row->sortKey(_filterId) >= key);
-		}).base();
+		});
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
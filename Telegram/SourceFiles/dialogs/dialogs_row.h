@@ -62,8 +62,22 @@ public:
 		return _userpic;
 	}
 
+	struct DateCache {
+		QDateTime date;
+		QString text;
+		QString langId;
+		QString timeFormat;
+		QString dateFormat;
+		int width = 0;
+		qint64 validTill = 0;
+	};
+	[[nodiscard]] DateCache &dateCache() const {
+		return _dateCache;
+	}
+
 private:
 	mutable std::shared_ptr<Data::CloudImageView> _userpic;
+	mutable DateCache _dateCache;
 	mutable std::unique_ptr<Ui::RippleAnimation> _ripple;
 
 };
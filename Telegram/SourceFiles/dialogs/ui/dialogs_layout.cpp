@@ -21,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/unread_badge.h"
 #include "ui/ui_utility.h"
 #include "lang/lang_keys.h"
+#include "lang/lang_instance.h"
 #include "support/support_helper.h"
 #include "main/main_session.h"
 #include "history/view/history_view_send_action.h"
@@ -52,33 +53,93 @@ const auto kPsaBadgePrefix = "cloud_lng_badge_psa_";
 			|| history->peer->asUser()->onlineTill > 0);
 }
 
-void PaintRowTopRight(Painter &p, const QString &text, QRect &rectForName, bool active, bool selected) {
-	const auto width = st::dialogsDateFont->width(text);
+void PaintRowTopRight(
+		Painter &p,
+		const QString &text,
+		int width,
+		QRect &rectForName,
+		bool active,
+		bool selected) {
 	rectForName.setWidth(rectForName.width() - width - st::dialogsDateSkip);
 	p.setFont(st::dialogsDateFont);
 	p.setPen(active ? st::dialogsDateFgActive : (selected ? st::dialogsDateFgOver : st::dialogsDateFg));
 	p.drawText(rectForName.left() + rectForName.width() + st::dialogsDateSkip, rectForName.top() + st::msgNameFont->height - st::msgDateFont->descent, text);
 }
 
-void PaintRowDate(Painter &p, QDateTime date, QRect &rectForName, bool active, bool selected) {
+void PaintRowTopRight(Painter &p, const QString &text, QRect &rectForName, bool active, bool selected) {
+	const auto width = st::dialogsDateFont->width(text);
+	PaintRowTopRight(p, text, width, rectForName, active, selected);
+}
+
+void ValidateRowDate(BasicRow::DateCache &cache, const QDateTime &date) {
+	// Formatting needs the local time and its zone, so it is done only
+	// when the row date, the language or the system formats change
+	// or the text may expire.
+	const auto nowSecs = QDateTime::currentSecsSinceEpoch();
+	const auto langId = Lang::GetInstance().id();
+	const auto &timeFormat = cTimeFormat();
+	const auto &dateFormat = cDateFormat();
+	if (cache.date == date
+		&& nowSecs < cache.validTill
+		&& cache.langId == langId
+		&& cache.timeFormat == timeFormat
+		&& cache.dateFormat == dateFormat) {
+		return;
+	}
 	const auto now = QDateTime::currentDateTime();
 	const auto &lastTime = date;
 	const auto nowDate = now.date();
 	const auto lastDate = lastTime.date();
 
-	const auto dt = [&] {
-		const auto wasSameDay = (lastDate == nowDate);
-		const auto wasRecently = qAbs(lastTime.secsTo(now)) < kRecentlyInSeconds;
+	const auto lastSecs = lastTime.toSecsSinceEpoch();
+	const auto wasSameDay = (lastDate == nowDate);
+	const auto wasRecently = qAbs(lastSecs - nowSecs) < kRecentlyInSeconds;
+	cache.text = [&] {
 		if (wasSameDay || wasRecently) {
-			return lastTime.toString(cTimeFormat());
+			return lastTime.toString(timeFormat);
 		} else if (lastDate.year() == nowDate.year()
 			&& lastDate.weekNumber() == nowDate.weekNumber()) {
 			return langDayOfWeek(lastDate);
 		} else {
-			return lastDate.toString(cDateFormat());
+			return lastDate.toString(dateFormat);
 		}
 	}();
-	PaintRowTopRight(p, dt, rectForName, active, selected);
+	cache.width = st::dialogsDateFont->width(cache.text);
+	cache.date = date;
+	cache.langId = langId;
+	cache.timeFormat = timeFormat;
+	cache.dateFormat = dateFormat;
+
+	// Any of the conditions above may change at the next midnight or when
+	// the date leaves (or enters) the recent interval.
+	auto validTill = QDateTime(nowDate.addDays(1), QTime(0, 0))
+		.toSecsSinceEpoch();
+	for (const auto edge : {
+			lastSecs - kRecentlyInSeconds,
+			lastSecs + kRecentlyInSeconds }) {
+		if (edge >= nowSecs) {
+			validTill = std::min(validTill, edge);
+		}
+	}
+	cache.validTill = validTill;
+}
+
+void PaintRowDate(
+		Painter &p,
+		not_null<const BasicRow*> row,
+		const QDateTime &date,
+		QRect &rectForName,
+		bool active,
+		bool selected) {
+	auto &cache = row->dateCache();
+	ValidateRowDate(cache, date);
+	PaintRowTopRight(
+		p,
+		cache.text,
+		cache.width,
+		rectForName,
+		active,
+		selected);
 }
 
 void PaintNarrowCounter(
@@ -440,7 +501,7 @@ void paintRow(
 		|| (supportMode
 			&& entry->session().supportHelper().isOccupiedBySomeone(history))) {
 		if (!promoted) {
-			PaintRowDate(p, date, rectForName, active, selected);
+			PaintRowDate(p, row, date, rectForName, active, selected);
 		}
 
 		auto availableWidth = namewidth;
@@ -500,7 +561,7 @@ void paintRow(
 		}
 	} else if (!item->isEmpty()) {
 		if (history && !promoted) {
-			PaintRowDate(p, date, rectForName, active, selected);
+			PaintRowDate(p, row, date, rectForName, active, selected);
 		}
 
 		paintItemCallback(nameleft, namewidth);
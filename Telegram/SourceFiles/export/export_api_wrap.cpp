@@ -15,6 +15,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/value_ordering.h"
 #include "base/bytes.h"
 #include "base/random.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
 #include <set>
 #include <deque>
 
@@ -104,6 +108,50 @@ private:
 
 };
 
+// Records files and last exported messages in the export folder,
+// so that the next export to the same place can continue from it.
+class ApiWrap::Manifest {
+public:
+	using Location = Data::FileLocation;
+
+	Manifest(const QString &folder, const QString &previousFolder);
+
+	std::optional<QString> findFile(const Location &location) const;
+	void saveFile(
+		const Location &location,
+		const QString &relativePath,
+		int64 size);
+
+	int32 lastMessageId(PeerId peerId, bool migrated) const;
+	void setLastMessageId(PeerId peerId, bool migrated, int32 id);
+	void chatDone(PeerId peerId);
+
+	void compact();
+
+private:
+	struct File {
+		QString relativePath;
+		int64 size = 0;
+	};
+	using ChatKey = std::pair<uint64, bool>;
+
+	void readPrevious();
+	void append(const QString &line);
+
+	[[nodiscard]] static QString FileLine(
+		const LocationKey &key,
+		const File &file);
+	[[nodiscard]] static QString ChatLine(const ChatKey &key, int32 id);
+
+	QString _folder;
+	QString _previousFolder;
+	std::map<LocationKey, File> _previousFiles;
+	std::map<LocationKey, File> _files;
+	std::map<ChatKey, int32> _previousChats;
+	std::map<ChatKey, int32> _chats;
+
+};
+
 struct ApiWrap::StartProcess {
 	FnMut<void(StartInfo)> done;
 
@@ -322,6 +370,151 @@ std::optional<QString> ApiWrap::LoadedFileCache::find(
 	return std::nullopt;
 }
 
+ApiWrap::Manifest::Manifest(
+	const QString &folder,
+	const QString &previousFolder)
+: _folder(folder)
+, _previousFolder(previousFolder) {
+	readPrevious();
+
+	// Chats not exported this time are still covered by the previous
+	// export, keep their marks so that the next export continues them.
+	_chats = _previousChats;
+	for (const auto &[key, id] : _chats) {
+		append(ChatLine(key, id));
+	}
+}
+
+void ApiWrap::Manifest::readPrevious() {
+	if (_previousFolder.isEmpty()) {
+		return;
+	}
+	auto file = QFile(Output::ManifestPath(_previousFolder));
+	if (!file.open(QIODevice::ReadOnly)) {
+		return;
+	}
+	while (!file.atEnd()) {
+		const auto line = QString::fromUtf8(file.readLine()).trimmed();
+		const auto kind = line.section(' ', 0, 0);
+		if (kind == u"file"_q) {
+			const auto type = line.section(' ', 1, 1).toULongLong();
+			const auto id = line.section(' ', 2, 2).toULongLong();
+			const auto size = line.section(' ', 3, 3).toLongLong();
+			const auto path = line.section(' ', 4);
+			if (size > 0 && !path.isEmpty()) {
+				_previousFiles[LocationKey{ type, id }] = File{ path, size };
+			}
+		} else if (kind == u"chat"_q) {
+			const auto peerId = line.section(' ', 1, 1).toULongLong();
+			const auto migrated = (line.section(' ', 2, 2) == u"1"_q);
+			const auto id = line.section(' ', 3, 3).toInt();
+			if (peerId && id > 0) {
+				_previousChats[ChatKey{ peerId, migrated }] = id;
+			}
+		}
+	}
+}
+
+QString ApiWrap::Manifest::FileLine(
+		const LocationKey &key,
+		const File &file) {
+	return u"file %1 %2 %3 %4"_q.arg(
+		QString::number(key.type),
+		QString::number(key.id),
+		QString::number(file.size),
+		file.relativePath);
+}
+
+QString ApiWrap::Manifest::ChatLine(const ChatKey &key, int32 id) {
+	return u"chat %1 %2 %3"_q.arg(
+		QString::number(key.first),
+		key.second ? u"1"_q : u"0"_q,
+		QString::number(id));
+}
+
+void ApiWrap::Manifest::append(const QString &line) {
+	// Append right away, so that an interrupted export keeps its progress.
+	auto file = QFile(Output::ManifestPath(_folder));
+	if (!file.open(QIODevice::Append)) {
+		if (!QDir().mkpath(_folder) || !file.open(QIODevice::Append)) {
+			return;
+		}
+	}
+	file.write((line + '\n').toUtf8());
+}
+
+void ApiWrap::Manifest::compact() {
+	auto file = QSaveFile(Output::ManifestPath(_folder));
+	if (!file.open(QIODevice::WriteOnly)) {
+		return;
+	}
+	for (const auto &[key, entry] : _files) {
+		file.write((FileLine(key, entry) + '\n').toUtf8());
+	}
+	for (const auto &[key, id] : _chats) {
+		file.write((ChatLine(key, id) + '\n').toUtf8());
+	}
+	file.commit();
+}
+
+void ApiWrap::Manifest::saveFile(
+		const Location &location,
+		const QString &relativePath,
+		int64 size) {
+	if (!location || relativePath.isEmpty() || size <= 0) {
+		return;
+	}
+	const auto key = ComputeLocationKey(location);
+	const auto entry = File{ relativePath, size };
+	const auto i = _files.find(key);
+	if (i != end(_files)
+		&& i->second.relativePath == relativePath
+		&& i->second.size == size) {
+		return;
+	}
+	_files[key] = entry;
+	append(FileLine(key, entry));
+}
+
+std::optional<QString> ApiWrap::Manifest::findFile(
+		const Location &location) const {
+	if (!location || _previousFolder.isEmpty()) {
+		return std::nullopt;
+	}
+	const auto i = _previousFiles.find(ComputeLocationKey(location));
+	if (i == end(_previousFiles)) {
+		return std::nullopt;
+	}
+	const auto path = _previousFolder + i->second.relativePath;
+	const auto info = QFileInfo(path);
+	return (info.isFile() && info.size() == i->second.size)
+		? std::make_optional(path)
+		: std::nullopt;
+}
+
+int32 ApiWrap::Manifest::lastMessageId(PeerId peerId, bool migrated) const {
+	const auto i = _previousChats.find(ChatKey{ peerId.value, migrated });
+	return (i != end(_previousChats)) ? i->second : 0;
+}
+
+void ApiWrap::Manifest::setLastMessageId(
+		PeerId peerId,
+		bool migrated,
+		int32 id) {
+	auto &already = _chats[ChatKey{ peerId.value, migrated }];
+	already = std::max(already, id);
+}
+
+void ApiWrap::Manifest::chatDone(PeerId peerId) {
+	for (const auto migrated : { false, true }) {
+		const auto key = ChatKey{ peerId.value, migrated };
+		const auto i = _chats.find(key);
+		if (i != end(_chats)) {
+			append(ChatLine(key, i->second));
+		}
+	}
+}
+
 ApiWrap::FileProcess::FileProcess(const QString &path, Output::Stats *stats)
 : file(path, stats) {
 }
@@ -403,12 +596,16 @@ rpl::producer<Output::Result> ApiWrap::ioErrors() const {
 
 void ApiWrap::startExport(
 		const Settings &settings,
+		const QString &previousExportPath,
 		Output::Stats *stats,
 		FnMut<void(StartInfo)> done) {
 	Expects(_settings == nullptr);
 	Expects(_startProcess == nullptr);
 
 	_settings = std::make_unique<Settings>(settings);
+	_manifest = std::make_unique<Manifest>(
+		_settings->path,
+		previousExportPath);
 	_stats = stats;
 	_startProcess = std::make_unique<StartProcess>();
 	_startProcess->done = std::move(done);
@@ -949,6 +1146,7 @@ void ApiWrap::requestMessages(
 	_chatProcess->fileProgress = std::move(progress);
 	_chatProcess->handleSlice = std::move(slice);
 	_chatProcess->done = std::move(done);
+	_chatProcess->largestIdPlusOne = firstSplitMessageId();
 
 	requestMessagesCount(0);
 }
@@ -957,11 +1155,13 @@ void ApiWrap::requestMessagesCount(int localSplitIndex) {
 	Expects(_chatProcess != nullptr);
 	Expects(localSplitIndex < _chatProcess->info.splits.size());
 
+	// With only new messages the count is taken after the last exported.
 	requestChatMessages(
 		_chatProcess->info.splits[localSplitIndex],
 		0, // offset_id
 		0, // add_offset
 		1, // limit
+		lastExportedMessageId(localSplitIndex), // min_id
 		[=](const MTPmessages_Messages &result) {
 		Expects(_chatProcess != nullptr);
 
@@ -1006,6 +1206,7 @@ void ApiWrap::checkFirstMessageDate(int localSplitIndex, int count) {
 		1, // offset_id
 		-1, // add_offset
 		1, // limit
+		0, // min_id
 		[=](const MTPmessages_Messages &result) {
 		Expects(_chatProcess != nullptr);
 
@@ -1031,6 +1232,10 @@ void ApiWrap::messagesCountLoaded(int localSplitIndex, int count) {
 void ApiWrap::finishExport(FnMut<void()> done) {
 	const auto guard = gsl::finally([&] { _takeoutId = std::nullopt; });
 
+	if (_manifest) {
+		_manifest->compact();
+	}
+
 	mainRequest(MTPaccount_FinishTakeoutSession(
 		MTP_flags(MTPaccount_FinishTakeoutSession::Flag::f_success)
 	)).done(std::move(done)).send();
@@ -1373,6 +1578,7 @@ void ApiWrap::requestMessagesSlice() {
 		_chatProcess->largestIdPlusOne,
 		-kMessagesSliceLimit,
 		kMessagesSliceLimit,
+		0, // min_id
 		[=](const MTPmessages_Messages &result) {
 		Expects(_chatProcess != nullptr);
 
@@ -1397,6 +1603,7 @@ void ApiWrap::requestChatMessages(
 		int offsetId,
 		int addOffset,
 		int limit,
+		int minId,
 		FnMut<void(MTPmessages_Messages&&)> done) {
 	Expects(_chatProcess != nullptr);
 
@@ -1427,7 +1634,7 @@ void ApiWrap::requestChatMessages(
 			MTP_int(addOffset),
 			MTP_int(limit),
 			MTP_int(0), // max_id
-			MTP_int(0), // min_id
+			MTP_int(minId),
 			MTP_long(0) // hash
 		)).done(doneHandler).send();
 	} else {
@@ -1438,7 +1645,7 @@ void ApiWrap::requestChatMessages(
 			MTP_int(addOffset),
 			MTP_int(limit),
 			MTP_int(0), // max_id
-			MTP_int(0), // min_id
+			MTP_int(minId),
 			MTP_long(0)  // hash
 		)).fail([=](const MTP::Error &error) {
 			Expects(_chatProcess != nullptr);
@@ -1455,6 +1662,7 @@ void ApiWrap::requestChatMessages(
 						offsetId,
 						addOffset,
 						limit,
+						minId,
 						base::take(_chatProcess->requestDone));
 					return true;
 				}
@@ -1549,6 +1757,10 @@ void ApiWrap::finishMessagesSlice() {
 		_chatProcess->largestIdPlusOne = slice.list.back().id + 1;
 		const auto splitIndex = _chatProcess->info.splits[
 			_chatProcess->localSplitIndex];
+		_manifest->setLastMessageId(
+			_chatProcess->info.peerId,
+			(splitIndex < 0),
+			slice.list.back().id);
 		if (splitIndex < 0) {
 			slice = AdjustMigrateMessageIds(std::move(slice));
 		}
@@ -1560,7 +1772,7 @@ void ApiWrap::finishMessagesSlice() {
 		&& (++_chatProcess->localSplitIndex
 			< _chatProcess->info.splits.size())) {
 		_chatProcess->lastSlice = false;
-		_chatProcess->largestIdPlusOne = 1;
+		_chatProcess->largestIdPlusOne = firstSplitMessageId();
 	}
 	if (!_chatProcess->lastSlice) {
 		requestMessagesSlice();
@@ -1623,9 +1835,30 @@ void ApiWrap::finishMessages() {
 	Expects(!_chatProcess->slice.has_value());
 
 	const auto process = base::take(_chatProcess);
+	_manifest->chatDone(process->info.peerId);
 	process->done();
 }
 
+int32 ApiWrap::firstSplitMessageId() const {
+	Expects(_chatProcess != nullptr);
+
+	return lastExportedMessageId(_chatProcess->localSplitIndex) + 1;
+}
+
+int32 ApiWrap::lastExportedMessageId(int localSplitIndex) const {
+	Expects(_chatProcess != nullptr);
+	Expects(_manifest != nullptr);
+	Expects(localSplitIndex < _chatProcess->info.splits.size());
+
+	if (!_settings->onlyNewMessages) {
+		return 0;
+	}
+	const auto splitIndex = _chatProcess->info.splits[localSplitIndex];
+	return _manifest->lastMessageId(
+		_chatProcess->info.peerId,
+		(splitIndex < 0));
+}
+
 bool ApiWrap::processFileLoad(
 		Data::File &file,
 		const Data::FileOrigin &origin,
@@ -1675,6 +1908,8 @@ bool ApiWrap::processFileLoad(
 		// Don't load thumbs for large files that we skip.
 		file.skipReason = SkipReason::FileSize;
 		return true;
+	} else if (copyExportedFile(file)) {
+		return true;
 	}
 	loadFile(file, origin, std::move(progress), std::move(done));
 	return false;
@@ -1703,6 +1938,34 @@ bool ApiWrap::writePreloadedFile(
 	return false;
 }
 
+bool ApiWrap::copyExportedFile(Data::File &file) {
+	Expects(_settings != nullptr);
+	Expects(_manifest != nullptr);
+
+	const auto source = _manifest->findFile(file.location);
+	if (!source) {
+		return false;
+	}
+	const auto relativePath = Output::File::PrepareRelativePath(
+		_settings->path,
+		file.suggestedPath);
+	const auto path = _settings->path + relativePath;
+	const auto folder = QFileInfo(path).absoluteDir();
+	if ((!folder.exists() && !folder.mkpath(folder.absolutePath()))
+		|| !QFile::copy(*source, path)) {
+		return false;
+	}
+	const auto size = QFileInfo(path).size();
+	if (_stats) {
+		_stats->incrementFiles();
+		_stats->incrementBytes(size);
+	}
+	file.relativePath = relativePath;
+	_fileCache->save(file.location, relativePath);
+	_manifest->saveFile(file.location, relativePath, size);
+	return true;
+}
+
 void ApiWrap::loadFile(
 		const Data::File &file,
 		const Data::FileOrigin &origin,
@@ -1842,6 +2105,10 @@ void ApiWrap::filePartDone(int64 offset, const MTPupload_File &result) {
 	auto process = base::take(_fileProcess);
 	const auto relativePath = process->relativePath;
 	_fileCache->save(process->location, relativePath);
+	_manifest->saveFile(
+		process->location,
+		relativePath,
+		process->file.size());
 	process->done(process->relativePath);
 }
 
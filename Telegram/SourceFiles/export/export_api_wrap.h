@@ -47,6 +47,7 @@ public:
 	};
 	void startExport(
 		const Settings &settings,
+		const QString &previousExportPath,
 		Output::Stats *stats,
 		FnMut<void(StartInfo)> done);
 
@@ -92,6 +93,7 @@ public:
 
 private:
 	class LoadedFileCache;
+	class Manifest;
 	struct StartProcess;
 	struct ContactsProcess;
 	struct UserpicsProcess;
@@ -155,6 +157,7 @@ private:
 		int offsetId,
 		int addOffset,
 		int limit,
+		int minId,
 		FnMut<void(MTPmessages_Messages&&)> done);
 	void loadMessagesFiles(Data::MessagesSlice &&slice);
 	void loadNextMessageFile();
@@ -164,6 +167,8 @@ private:
 	void loadMessageThumbDone(const QString &relativePath);
 	void finishMessagesSlice();
 	void finishMessages();
+	int32 firstSplitMessageId() const;
+	int32 lastExportedMessageId(int localSplitIndex) const;
 
 	[[nodiscard]] Data::Message *currentFileMessage() const;
 	[[nodiscard]] Data::FileOrigin currentFileMessageOrigin() const;
@@ -180,6 +185,7 @@ private:
 	bool writePreloadedFile(
 		Data::File &file,
 		const Data::FileOrigin &origin);
+	bool copyExportedFile(Data::File &file);
 	void loadFile(
 		const Data::File &file,
 		const Data::FileOrigin &origin,
@@ -220,6 +226,7 @@ private:
 
 	std::unique_ptr<StartProcess> _startProcess;
 	std::unique_ptr<LoadedFileCache> _fileCache;
+	std::unique_ptr<Manifest> _manifest;
 	std::unique_ptr<ContactsProcess> _contactsProcess;
 	std::unique_ptr<UserpicsProcess> _userpicsProcess;
 	std::unique_ptr<OtherDataProcess> _otherDataProcess;
@@ -103,6 +103,7 @@ private:
 
 	ApiWrap _api;
 	Settings _settings;
+	QString _previousExportPath;
 	Environment _environment;
 
 	Data::DialogsInfo _dialogsInfo;
@@ -248,6 +249,7 @@ void ControllerObject::startExport(
 	_settings = NormalizeSettings(settings);
 	_environment = environment;
 
+	_previousExportPath = Output::PreviousExportPath(_settings);
 	_settings.path = Output::NormalizePath(_settings);
 	_writer = Output::CreateWriter(_settings.format);
 	fillExportSteps();
@@ -354,9 +356,11 @@ void ControllerObject::exportNext() {
 
 void ControllerObject::initialize() {
 	setState(stateInitializing());
-	_api.startExport(_settings, &_stats, [=](ApiWrap::StartInfo info) {
-		initialized(info);
-	});
+	_api.startExport(
+		_settings,
+		_previousExportPath,
+		&_stats,
+		[=](ApiWrap::StartInfo info) { initialized(info); });
 }
 
 void ControllerObject::initialized(const ApiWrap::StartInfo &info) {
@@ -81,6 +81,10 @@ struct Settings {
 	TimeId singlePeerFrom = 0;
 	TimeId singlePeerTill = 0;
 
+	// Continue the previous export to the same folder from its last
+	// exported messages instead of exporting chats from the beginning.
+	bool onlyNewMessages = false;
+
 	TimeId availableAt = 0;
 
 	bool onlySinglePeer() const {
@@ -14,9 +14,16 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <QtCore/QDir>
 #include <QtCore/QDate>
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
 
 namespace Export {
 namespace Output {
+namespace {
+
+constexpr auto kManifestName = "export_manifest.txt";
+
+} // namespace
 
 QString NormalizePath(const Settings &settings) {
 	QDir folder(settings.path);
@@ -46,6 +53,36 @@ QString NormalizePath(const Settings &settings) {
 	return result;
 }
 
+QString ManifestPath(const QString &folder) {
+	return (folder.endsWith('/') ? folder : (folder + '/'))
+		+ QString::fromLatin1(kManifestName);
+}
+
+QString PreviousExportPath(const Settings &settings) {
+	// Exports go either to the chosen folder itself
+	// or to its dated subfolders, look for the latest of them.
+	const auto base = QDir(settings.path);
+	if (!base.exists()) {
+		return QString();
+	}
+	auto candidates = QStringList(base.absolutePath());
+	const auto list = base.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+	for (const auto &name : list) {
+		candidates.push_back(base.absoluteFilePath(name));
+	}
+	auto result = QString();
+	auto latest = QDateTime();
+	for (const auto &folder : candidates) {
+		const auto info = QFileInfo(ManifestPath(folder));
+		if (info.isFile()
+			&& (latest.isNull() || info.lastModified() > latest)) {
+			latest = info.lastModified();
+			result = folder + '/';
+		}
+	}
+	return result;
+}
+
 std::unique_ptr<AbstractWriter> CreateWriter(Format format) {
 	switch (format) {
 	case Format::Html: return std::make_unique<HtmlWriter>();
@@ -28,6 +28,8 @@ struct Environment;
 namespace Output {
 
 QString NormalizePath(const Settings &settings);
+QString ManifestPath(const QString &folder);
+QString PreviousExportPath(const Settings &settings);
 
 struct Result;
 class Stats;
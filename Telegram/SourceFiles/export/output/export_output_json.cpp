@@ -23,12 +23,31 @@ namespace {
 
 using Context = details::JsonContext;
 
+[[nodiscard]] bool NeedsEscaping(const char *begin, const char *end) {
+	for (auto p = begin; p != end; ++p) {
+		const auto ch = *p;
+		if ((ch >= 0 && ch < 32)
+			|| ch == '"'
+			|| ch == '\\'
+			|| ch == char(0xE2)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 QByteArray SerializeString(const QByteArray &value) {
 	const auto size = value.size();
 	const auto begin = value.data();
 	const auto end = begin + size;
 
 	auto result = QByteArray();
+	if (!NeedsEscaping(begin, end)) {
+		// Most of the strings are copied as is, don't over-allocate.
+		result.reserve(2 + size);
+		result.append('"').append(value).append('"');
+		return result;
+	}
 	result.reserve(2 + size * 4);
 	result.append('"');
 	for (auto p = begin; p != end; ++p) {
@@ -105,6 +124,13 @@ QByteArray SerializeObject(
 
 	auto first = true;
 	auto result = QByteArray();
+	auto size = 3 + indent.size();
+	for (const auto &[key, value] : values) {
+		if (!value.isEmpty()) {
+			size += next.size() + key.size() + value.size() + 6;
+		}
+	}
+	result.reserve(size);
 	result.append('{');
 	for (const auto &[key, value] : values) {
 		if (value.isEmpty()) {
@@ -130,6 +156,11 @@ QByteArray SerializeArray(
 
 	auto first = true;
 	auto result = QByteArray();
+	auto size = 3 + indent.size();
+	for (const auto &value : values) {
+		size += next.size() + value.size() + 1;
+	}
+	result.reserve(size);
 	result.append('[');
 	for (const auto &value : values) {
 		if (first) {
@@ -252,6 +252,7 @@ void SettingsWidget::setupPathAndFormat(
 	if (_singlePeerId != 0) {
 		addFormatAndLocationLabel(container);
 		addLimitsLabel(container);
+		addOnlyNewOption(container);
 		return;
 	}
 	const auto formatGroup = std::make_shared<Ui::RadioenumGroup<Format>>(
@@ -275,6 +276,7 @@ void SettingsWidget::setupPathAndFormat(
 	addLocationLabel(container);
 	addFormatOption(tr::lng_export_option_html(tr::now), Format::Html);
 	addFormatOption(tr::lng_export_option_json(tr::now), Format::Json);
+	addOnlyNewOption(container);
 }
 
 void SettingsWidget::addLocationLabel(
@@ -593,6 +595,29 @@ not_null<Ui::Checkbox*> SettingsWidget::addOptionWithAbout(
 	return result;
 }
 
+void SettingsWidget::addOnlyNewOption(
+		not_null<Ui::VerticalLayout*> container) {
+	const auto checkbox = container->add(
+		object_ptr<Ui::Checkbox>(
+			container,
+			tr::lng_export_option_only_new(tr::now),
+			readData().onlyNewMessages,
+			st::defaultBoxCheckbox),
+		st::exportSettingPadding);
+	checkbox->checkedChanges(
+	) | rpl::start_with_next([=](bool checked) {
+		changeData([&](Settings &data) {
+			data.onlyNewMessages = checked;
+		});
+	}, checkbox->lifetime());
+	container->add(
+		object_ptr<Ui::FlatLabel>(
+			container,
+			tr::lng_export_option_only_new_about(tr::now),
+			st::exportAboutOptionLabel),
+		st::exportAboutOptionPadding);
+}
+
 void SettingsWidget::addChatOption(
 		not_null<Ui::VerticalLayout*> container,
 		const QString &text,
@@ -88,6 +88,7 @@ private:
 		not_null<Ui::VerticalLayout*> container);
 	void addLimitsLabel(
 		not_null<Ui::VerticalLayout*> container);
+	void addOnlyNewOption(not_null<Ui::VerticalLayout*> container);
 	void chooseFolder();
 	void chooseFormat();
 	void refreshButtons(
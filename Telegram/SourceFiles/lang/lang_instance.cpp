@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "lang/lang_instance.h"
 
 #include "core/application.h"
+#include "core/version.h"
 #include "storage/serialize_common.h"
 #include "storage/localstorage.h"
 #include "ui/boxes/confirm_box.h"
@@ -20,7 +21,8 @@ namespace Lang {
 namespace {
 
 const auto kSerializeVersionTag = qsl("#new");
-constexpr auto kSerializeVersion = 1;
+constexpr auto kSerializeVersion = 2;
+constexpr auto kSerializeVersionWithoutParsed = 1;
 constexpr auto kDefaultLanguage = "en"_cs;
 constexpr auto kCloudLangPackName = "tdesktop"_cs;
 constexpr auto kCustomLanguage = "#custom"_cs;
@@ -397,6 +399,20 @@ QByteArray Instance::serialize() const {
 		size += Serialize::bytearraySize(nonDefault.first)
 			+ Serialize::bytearraySize(nonDefault.second);
 	}
+
+	// Parsed values let the next launch skip parsing with the same build.
+	auto parsed = std::vector<std::pair<ushort, QString>>();
+	parsed.reserve(_nonDefaultValues.size());
+	for (const auto &[key, value] : _nonDefaultValues) {
+		ParseKeyValue(key, value, [&](ushort index, QString &&value) {
+			parsed.emplace_back(index, std::move(value));
+		});
+	}
+	size += sizeof(quint64) // kKeysChecksum
+		+ sizeof(qint32); // parsed.size()
+	for (const auto &[index, value] : parsed) {
+		size += sizeof(quint16) + Serialize::stringSize(value);
+	}
 	const auto base = _base ? _base->serialize() : QByteArray();
 	size += Serialize::bytearraySize(base);
 
@@ -420,6 +436,10 @@ QByteArray Instance::serialize() const {
 		for (const auto &nonDefault : _nonDefaultValues) {
 			stream << nonDefault.first << nonDefault.second;
 		}
+		stream << quint64(kKeysChecksum) << qint32(parsed.size());
+		for (const auto &[index, value] : parsed) {
+			stream << quint16(index) << value;
+		}
 		stream << base;
 	}
 	return result;
@@ -449,7 +469,8 @@ void Instance::fillFromSerialized(
 			>> nonDefaultValuesCount;
 	} else {
 		stream >> serializeVersion;
-		if (serializeVersion == kSerializeVersion) {
+		if (serializeVersion == kSerializeVersion
+			|| serializeVersion == kSerializeVersionWithoutParsed) {
 			stream
 				>> id
 				>> pluralId
@@ -506,6 +527,36 @@ void Instance::fillFromSerialized(
 		nonDefaultStrings.push_back(value);
 	}
 
+	auto parsed = std::vector<std::pair<ushort, QString>>();
+	auto parsedValid = false;
+	if (!legacyFormat && serializeVersion == kSerializeVersion) {
+		quint64 keysChecksum = 0;
+		qint32 parsedCount = 0;
+		stream >> keysChecksum >> parsedCount;
+		if (stream.status() != QDataStream::Ok
+			|| parsedCount < 0
+			|| parsedCount > kLangValuesLimit) {
+			LOG(("Lang Error: "
+				"Could not read data from serialized langpack."));
+			return;
+		}
+		parsedValid = (keysChecksum == kKeysChecksum)
+			&& (dataAppVersion == AppVersion);
+		parsed.reserve(parsedValid ? parsedCount : 0);
+		for (auto i = 0; i != parsedCount; ++i) {
+			quint16 index = 0;
+			QString value;
+			stream >> index >> value;
+			if (stream.status() != QDataStream::Ok) {
+				LOG(("Lang Error: "
+					"Could not read data from serialized langpack."));
+				return;
+			} else if (parsedValid && index < kKeysCount) {
+				parsed.emplace_back(index, std::move(value));
+			}
+		}
+	}
+
 	_base = nullptr;
 	QByteArray base;
 	if (legacyFormat) {
@@ -545,14 +596,32 @@ void Instance::fillFromSerialized(
 	_customFilePathAbsolute = customFilePathAbsolute;
 	_customFilePathRelative = customFilePathRelative;
 	_customFileContent = customFileContent;
-	LOG(("Lang Info: Loaded cached, keys: %1").arg(nonDefaultValuesCount));
-	for (auto i = 0, count = nonDefaultValuesCount * 2; i != count; i += 2) {
-		applyValue(nonDefaultStrings[i], nonDefaultStrings[i + 1]);
+	LOG(("Lang Info: Loaded cached, keys: %1%2"
+		).arg(nonDefaultValuesCount
+		).arg(parsedValid ? " (parsed)" : ""));
+	const auto count = nonDefaultValuesCount * 2;
+	if (parsedValid) {
+		for (auto i = 0; i != count; i += 2) {
+			_nonDefaultValues[nonDefaultStrings[i]] = nonDefaultStrings[i + 1];
+		}
+		for (auto &[index, value] : parsed) {
+			applyParsedValue(index, std::move(value));
+		}
+	} else {
+		for (auto i = 0; i != count; i += 2) {
+			applyValue(nonDefaultStrings[i], nonDefaultStrings[i + 1]);
+		}
 	}
 	updatePluralRules();
 	updateChoosingStickerReplacement();
 
 	_idChanges.fire_copy(_id);
+
+	if (!parsedValid && !_derived) {
+		// The parsed values were saved by another app version or are
+		// missing, write them again so the next launch can use them.
+		crl::on_main([] { Local::writeLangPack(); });
+	}
 }
 
 void Instance::loadFromContent(const QByteArray &content) {
@@ -736,21 +805,25 @@ QString Instance::getNonDefaultValue(const QByteArray &key) const {
 void Instance::applyValue(const QByteArray &key, const QByteArray &value) {
 	_nonDefaultValues[key] = value;
 	ParseKeyValue(key, value, [&](ushort key, QString &&value) {
-		_nonDefaultSet[key] = 1;
+		applyParsedValue(key, std::move(value));
+	});
+}
+
+void Instance::applyParsedValue(ushort key, QString &&value) {
+	_nonDefaultSet[key] = 1;
+	if (!_derived) {
+		_values[key] = std::move(value);
+	} else if (!_derived->_nonDefaultSet[key]) {
+		_derived->_values[key] = std::move(value);
+	}
+	if (key == tr::lng_send_action_choose_sticker.base
+		|| key == tr::lng_user_action_choose_sticker.base) {
 		if (!_derived) {
-			_values[key] = std::move(value);
-		} else if (!_derived->_nonDefaultSet[key]) {
-			_derived->_values[key] = std::move(value);
-		}
-		if (key == tr::lng_send_action_choose_sticker.base
-			|| key == tr::lng_user_action_choose_sticker.base) {
-			if (!_derived) {
-				updateChoosingStickerReplacement();
-			} else {
-				_derived->updateChoosingStickerReplacement();
-			}
+			updateChoosingStickerReplacement();
+		} else {
+			_derived->updateChoosingStickerReplacement();
 		}
-	});
+	}
 }
 
 void Instance::updatePluralRules() {
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/core_settings.h"
 #include "core/shortcuts.h"
 #include "core/crash_reports.h"
+#include "core/startup_trace.h"
 #include "main/main_account.h"
 #include "main/main_session.h"
 #include "data/data_session.h"
@@ -64,6 +65,8 @@ bool Domain::started() const {
 Storage::StartResult Domain::start(const QByteArray &passcode) {
 	Expects(!started());
 
+	const auto span = Core::StartupTrace::Span("Main::Domain::start");
+
 	const auto result = _local->start(passcode);
 	if (result == Storage::StartResult::Success) {
 		activateAfterStarting();
@@ -23,6 +23,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/file_download.h"
 #include "storage/download_manager_mtproto.h"
 #include "storage/file_upload.h"
+#include "storage/localimageloader.h"
 #include "storage/storage_account.h"
 #include "storage/storage_facade.h"
 #include "storage/storage_account.h"
@@ -39,6 +40,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "support/support_helper.h"
 #include "lang/lang_keys.h"
 #include "core/application.h"
+#include "core/startup_trace.h"
 #include "ui/text/text_utilities.h"
 #include "ui/layers/generic_box.h"
 #include "styles/style_layers.h"
@@ -153,6 +155,7 @@ Session::Session(
 
 		// Storage::Account uses Main::Account::session() in those methods.
 		// So they can't be called during Main::Session construction.
+		const auto span = Core::StartupTrace::Span("Session stickers read");
 		local().readInstalledStickers();
 		local().readInstalledMasks();
 		local().readFeaturedStickers();
@@ -200,6 +203,7 @@ void Session::finishLogout() {
 Session::~Session() {
 	unlockTerms();
 	data().clear();
+	FileLoadTask::ClearMediaInformationCache();
 	ClickHandler::clearActive();
 	ClickHandler::unpressed();
 }
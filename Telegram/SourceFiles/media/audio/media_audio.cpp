@@ -717,6 +717,8 @@ void Mixer::onError(const AudioMsgId &audio) {
 void Mixer::onStopped(const AudioMsgId &audio) {
 	updated(audio);
 
+	logPlaybackStats(audio.type());
+
 	QMutexLocker lock(&AudioMutex);
 	auto type = audio.type();
 	if (type == AudioMsgId::Type::Voice) {
@@ -847,11 +849,12 @@ void Mixer::play(
 		if (!current) return;
 
 		if (current->state.id != audio) {
+			logPlaybackStats(type);
 			if (fadedStop(type, &fadedStart)) {
 				stopped = current->state.id;
 			}
 			if (current->state.id) {
-				loaderOnCancel(current->state.id);
+				cancelLoading(current->state.id);
 				faderOnTimer();
 			}
 			if (type != AudioMsgId::Type::Video) {
@@ -883,6 +886,7 @@ void Mixer::play(
 			? State::Starting
 			: State::Playing;
 		current->loading = true;
+		_loader->invalidateLoading(type);
 		loaderOnStart(current->state.id, positionMs);
 		if (type == AudioMsgId::Type::Voice) {
 			suppressSong();
@@ -1152,7 +1156,7 @@ void Mixer::stop(const AudioMsgId &audio) {
 			unsuppressSong();
 		} else if (type == AudioMsgId::Type::Video) {
 			track->clear();
-			loaderOnCancel(audio);
+			cancelLoading(audio);
 		}
 	}
 	if (current) updated(current);
@@ -1205,7 +1209,7 @@ void Mixer::stopAndClear() {
 		auto clearAndCancel = [this](AudioMsgId::Type type, int index) {
 			auto track = trackForType(type, index);
 			if (track->state.id) {
-				loaderOnCancel(track->state.id);
+				cancelLoading(track->state.id);
 			}
 			track->clear();
 		};
@@ -1234,7 +1238,65 @@ void Mixer::setStoppedState(Track *current, State state) {
 		alSourcef(current->stream.source, AL_GAIN, 1);
 	}
 	if (current->state.id) {
-		loaderOnCancel(current->state.id);
+		cancelLoading(current->state.id);
+	}
+}
+
+// Thread: Any. Must be locked: AudioMutex.
+void Mixer::cancelLoading(const AudioMsgId &audio) {
+	_loader->invalidateLoading(audio.type());
+	loaderOnCancel(audio);
+}
+
+Mixer::Counters *Mixer::countersForType(AudioMsgId::Type type) {
+	switch (type) {
+	case AudioMsgId::Type::Voice: return &_audioCounters;
+	case AudioMsgId::Type::Song: return &_songCounters;
+	case AudioMsgId::Type::Video: return &_videoCounters;
+	}
+	return nullptr;
+}
+
+const Mixer::Counters *Mixer::countersForType(
+		AudioMsgId::Type type) const {
+	return const_cast<Mixer*>(this)->countersForType(type);
+}
+
+// Thread: Any.
+void Mixer::countUnderrun(AudioMsgId::Type type) {
+	if (const auto counters = countersForType(type)) {
+		++counters->underruns;
+	}
+}
+
+// Thread: Any.
+void Mixer::countFullQueueWait(AudioMsgId::Type type) {
+	if (const auto counters = countersForType(type)) {
+		++counters->fullQueueWaits;
+	}
+}
+
+// Thread: Any.
+PlaybackStats Mixer::takePlaybackStats(AudioMsgId::Type type) {
+	const auto counters = countersForType(type);
+	if (!counters) {
+		return PlaybackStats();
+	}
+	return {
+		.underruns = counters->underruns.exchange(0),
+		.fullQueueWaits = counters->fullQueueWaits.exchange(0),
+	};
+}
+
+// Thread: Any.
+void Mixer::logPlaybackStats(AudioMsgId::Type type) {
+	const auto stats = takePlaybackStats(type);
+	if (stats.underruns) {
+		DEBUG_LOG(("Audio Info: playback stats for type %1, "
+			"underruns: %2, full queue waits: %3."
+			).arg(int(type)
+			).arg(stats.underruns
+			).arg(stats.fullQueueWaits));
 	}
 }
 
@@ -1421,6 +1483,14 @@ int32 Fader::updateOnePlayback(Mixer::Track *track, bool &hasPlaying, bool &hasF
 	const auto waitingForDataOld = track->state.waitingForData;
 	track->state.waitingForData = stoppedAtEnd
 		&& (track->state.state != State::Stopping);
+	if (track->state.waitingForData
+		&& !waitingForDataOld
+		&& !track->loaded
+		&& (track->state.state == State::Playing)) {
+		// The source drained all its queued buffers before the loader
+		// managed to provide more data.
+		mixer()->countUnderrun(track->state.id.type());
+	}
 	const auto fullPosition = track->bufferedPosition + positionInBuffered;
 
 	auto playing = (track->state.state == State::Playing);
@@ -17,6 +17,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <QtCore/QTimer>
 
+#include <atomic>
+
 namespace Media {
 struct ExternalSoundData;
 struct ExternalSoundPart;
@@ -130,6 +132,14 @@ struct TrackState {
 	bool waitingForData = false;
 };
 
+struct PlaybackStats {
+	int underruns = 0;
+
+	// Decoded samples waiting for a free buffer, it is back-pressure
+	// of a filled queue and grows with the playback time.
+	int fullQueueWaits = 0;
+};
+
 class Mixer final : public QObject {
 	Q_OBJECT
 
@@ -163,6 +173,9 @@ public:
 
 	TrackState currentState(AudioMsgId::Type type);
 
+	// Thread: Any.
+	[[nodiscard]] PlaybackStats takePlaybackStats(AudioMsgId::Type type);
+
 	// Thread: Main. Must be locked: AudioMutex.
 	void prepareToCloseDevice();
 
@@ -275,6 +288,12 @@ private:
 
 	// Thread: Any. Must be locked: AudioMutex.
 	void setStoppedState(Track *current, State state = State::Stopped);
+	void cancelLoading(const AudioMsgId &audio);
+
+	// Thread: Any.
+	void countUnderrun(AudioMsgId::Type type);
+	void countFullQueueWait(AudioMsgId::Type type);
+	void logPlaybackStats(AudioMsgId::Type type);
 
 	Track *trackForType(AudioMsgId::Type type, int index = -1); // -1 uses currentIndex(type)
 	const Track *trackForType(AudioMsgId::Type type, int index = -1) const;
@@ -308,6 +327,17 @@ private:
 	QAtomicInt _volumeVideo;
 	QAtomicInt _volumeSong;
 
+	struct Counters {
+		std::atomic<int> underruns = 0;
+		std::atomic<int> fullQueueWaits = 0;
+	};
+	Counters *countersForType(AudioMsgId::Type type);
+	const Counters *countersForType(AudioMsgId::Type type) const;
+
+	Counters _audioCounters;
+	Counters _songCounters;
+	Counters _videoCounters;
+
 	friend class Fader;
 	friend class Loaders;
 
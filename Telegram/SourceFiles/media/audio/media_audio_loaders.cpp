@@ -57,6 +57,21 @@ void Loaders::forceToBufferExternal(const AudioMsgId &audioId) {
 	}
 }
 
+void Loaders::invalidateLoading(AudioMsgId::Type type) {
+	if (const auto generation = generationForType(type)) {
+		generation->fetch_add(1, std::memory_order_release);
+	}
+}
+
+std::atomic<uint32> *Loaders::generationForType(AudioMsgId::Type type) {
+	switch (type) {
+	case AudioMsgId::Type::Voice: return &_audioGeneration;
+	case AudioMsgId::Type::Song: return &_songGeneration;
+	case AudioMsgId::Type::Video: return &_videoGeneration;
+	}
+	return nullptr;
+}
+
 void Loaders::videoSoundAdded() {
 	auto queues = decltype(_fromExternalQueues)();
 	auto forces = decltype(_fromExternalForceToBuffer)();
@@ -153,6 +168,10 @@ void Loaders::onLoad(const AudioMsgId &audio) {
 void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 	auto err = SetupNoErrorStarted;
 	auto type = audio.type();
+	const auto generation = generationForType(type);
+	const auto loadingGeneration = generation
+		? generation->load(std::memory_order_acquire)
+		: 0;
 	auto l = setupLoader(audio, err, positionMs);
 	if (!l) {
 		if (err == SetupErrorAtStart) {
@@ -201,8 +220,12 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 			break;
 		}
 
-		QMutexLocker lock(internal::audioPlayerMutex());
-		if (!checkLoader(type)) {
+		// Don't contend with the main and fader threads for the AudioMutex
+		// on every decoded packet, the track is checked once more below.
+		const auto actual = generation
+			? generation->load(std::memory_order_acquire)
+			: loadingGeneration;
+		if (actual != loadingGeneration) {
 			clear(type);
 			return;
 		}
@@ -246,6 +269,7 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		}
 
 		if (bufferIndex < 0) { // No free buffers, wait.
+			mixer()->countFullQueueWait(type);
 			l->saveDecodedSamples(&samples, &samplesCount);
 			return;
 		} else if (l->forceToBuffer()) {
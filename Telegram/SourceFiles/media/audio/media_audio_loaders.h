@@ -23,6 +23,10 @@ public:
 	Loaders(QThread *thread);
 	void feedFromExternal(ExternalSoundPart &&part);
 	void forceToBufferExternal(const AudioMsgId &audioId);
+
+	// Thread: Any.
+	void invalidateLoading(AudioMsgId::Type type);
+
 	~Loaders();
 
 Q_SIGNALS:
@@ -44,6 +48,12 @@ private:
 	std::unique_ptr<AudioPlayerLoader> _songLoader;
 	std::unique_ptr<AudioPlayerLoader> _videoLoader;
 
+	// Bumped by the mixer whenever the track of the given type changes,
+	// so the decoding loop can bail out without taking the AudioMutex.
+	std::atomic<uint32> _audioGeneration = 0;
+	std::atomic<uint32> _songGeneration = 0;
+	std::atomic<uint32> _videoGeneration = 0;
+
 	QMutex _fromExternalMutex;
 	base::flat_map<
 		AudioMsgId,
@@ -67,6 +77,7 @@ private:
 		SetupError &err,
 		crl::time positionMs);
 	Mixer::Track *checkLoader(AudioMsgId::Type type);
+	std::atomic<uint32> *generationForType(AudioMsgId::Type type);
 
 };
 
@@ -108,6 +108,11 @@ constexpr auto kSeekTimeMs = 5 * crl::time(1000);
 // even though it reports that max texture size is 16384.
 constexpr auto kMaxDisplayImageSize = 4096;
 
+// Larger images are decoded in the background, showing a blurred
+// thumbnail of the final size in the meantime.
+constexpr auto kDecodeInBackgroundArea = 2048 * 2048;
+constexpr auto kDecodingPreviewSize = 320;
+
 // Preload X message ids before and after current.
 constexpr auto kIdsLimit = 48;
 
@@ -159,15 +164,34 @@ QWidget *PipDelegate::pipParentWidget() {
 }
 
 [[nodiscard]] QImage PrepareStaticImage(Images::ReadArgs &&args) {
-	auto read = Images::Read(std::move(args));
-	return (read.image.width() > kMaxDisplayImageSize
-		|| read.image.height() > kMaxDisplayImageSize)
-		? read.image.scaled(
+	args.maxSize = QSize(kMaxDisplayImageSize, kMaxDisplayImageSize);
+	return Images::Read(std::move(args)).image;
+}
+
+[[nodiscard]] QSize ReadStaticImageSize(const Images::ReadArgs &args) {
+	auto content = args.content;
+	auto buffer = QBuffer(&content);
+	auto reader = QImageReader();
+	if (content.isEmpty()) {
+		reader.setFileName(args.path);
+	} else {
+		reader.setDevice(&buffer);
+	}
+	reader.setAutoTransform(true);
+	auto result = reader.size();
+	if (result.isEmpty()) {
+		return QSize();
+	} else if (reader.transformation()
+		& QImageIOHandler::TransformationRotate90) {
+		result.transpose();
+	}
+	return (result.width() > kMaxDisplayImageSize
+		|| result.height() > kMaxDisplayImageSize)
+		? result.scaled(
 			kMaxDisplayImageSize,
 			kMaxDisplayImageSize,
-			Qt::KeepAspectRatio,
-			Qt::SmoothTransformation)
-		: read.image;
+			Qt::KeepAspectRatio)
+		: result;
 }
 
 [[nodiscard]] bool IsSemitransparent(const QImage &image) {
@@ -655,9 +679,51 @@ void OverlayWidget::setStaticContent(QImage image) {
 	}
 	image.setDevicePixelRatio(cRetinaFactor());
 	_staticContent = std::move(image);
+	_staticContentSize = _staticContent.size();
 	_staticContentTransparent = IsSemitransparent(_staticContent);
 }
 
+void OverlayWidget::initStaticContent(
+		Images::ReadArgs &&args,
+		Core::FileLocation location) {
+	Expects(_document != nullptr);
+
+	const auto size = ReadStaticImageSize(args);
+	const auto thumbnail = _documentMedia->thumbnail();
+	if (!thumbnail || size.width() * size.height() <= kDecodeInBackgroundArea) {
+		setStaticContent(PrepareStaticImage(std::move(args)));
+		return;
+	}
+	const auto preview = size.scaled(
+		kDecodingPreviewSize,
+		kDecodingPreviewSize,
+		Qt::KeepAspectRatio);
+	setStaticContent(thumbnail->pixNoCache(
+		preview,
+		{ .options = Images::Option::Blur }
+	).toImage());
+	_staticContentSize = size;
+
+	const auto document = _document;
+	const auto id = _staticContentRequestId = base::RandomValue<uint64>();
+	const auto weak = Ui::MakeWeak(_widget);
+	crl::async([=, args = std::move(args)]() mutable {
+		location.accessEnable();
+		auto image = PrepareStaticImage(std::move(args));
+		location.accessDisable();
+		crl::on_main(weak, [=, image = std::move(image)]() mutable {
+			if (id != _staticContentRequestId
+				|| _document != document
+				|| image.isNull()) {
+				return;
+			}
+			_staticContentRequestId = 0;
+			setStaticContent(std::move(image));
+			update();
+		});
+	});
+}
+
 bool OverlayWidget::contentShown() const {
 	return _photo || documentContentShown();
 }
@@ -2483,6 +2549,7 @@ void OverlayWidget::displayPhoto(not_null<PhotoData*> photo) {
 	refreshMediaViewer();
 
 	_staticContent = QImage();
+	_staticContentRequestId = 0;
 	if (_photo->videoCanBePlayed()) {
 		initStreaming();
 	}
@@ -2535,6 +2602,7 @@ void OverlayWidget::displayDocument(
 		const StartStreaming &startStreaming) {
 	_fullScreenVideo = false;
 	_staticContent = QImage();
+	_staticContentRequestId = 0;
 	clearStreaming(_document != doc);
 	destroyThemePreview();
 	assignMediaPointer(doc);
@@ -2572,21 +2640,18 @@ void OverlayWidget::displayDocument(
 				_document->saveFromDataSilent();
 				auto &location = _document->location(true);
 				if (location.accessEnable()) {
-					setStaticContent(PrepareStaticImage({
+					initStaticContent({
 						.path = location.name(),
-					}));
-					if (!_staticContent.isNull()) {
-						_touchbarDisplay.fire(TouchBarItemType::Photo);
-					}
+					}, location);
 				} else {
-					setStaticContent(PrepareStaticImage({
+					initStaticContent({
 						.content = _documentMedia->bytes(),
-					}));
-					if (!_staticContent.isNull()) {
-						_touchbarDisplay.fire(TouchBarItemType::Photo);
-					}
+					}, location);
 				}
 				location.accessDisable();
+				if (!_staticContent.isNull()) {
+					_touchbarDisplay.fire(TouchBarItemType::Photo);
+				}
 			}
 		}
 	}
@@ -2643,7 +2708,7 @@ void OverlayWidget::displayDocument(
 		updateThemePreviewGeometry();
 	} else if (!_staticContent.isNull()) {
 		const auto size = style::ConvertScale(
-			flipSizeByRotation(_staticContent.size()));
+			flipSizeByRotation(_staticContentSize));
 		_w = size.width();
 		_h = size.height();
 	} else if (videoShown()) {
@@ -2906,10 +2971,24 @@ void OverlayWidget::updatePowerSaveBlocker(
 
 QImage OverlayWidget::transformedShownContent() const {
 	return transformShownContent(
-		videoShown() ? currentVideoFrameImage() : _staticContent,
+		videoShown() ? currentVideoFrameImage() : fullStaticContent(),
 		finalContentRotation());
 }
 
+QImage OverlayWidget::fullStaticContent() const {
+	if (!_staticContentRequestId || !_document) {
+		return _staticContent;
+	}
+	// While decoding in the background _staticContent is only
+	// a blurred preview, so decode the image here right away.
+	auto &location = _document->location(true);
+	auto result = location.accessEnable()
+		? PrepareStaticImage({ .path = location.name() })
+		: PrepareStaticImage({ .content = _documentMedia->bytes() });
+	location.accessDisable();
+	return result.isNull() ? _staticContent : result;
+}
+
 QImage OverlayWidget::transformShownContent(
 		QImage content,
 		int rotation) const {
@@ -4785,6 +4864,7 @@ void OverlayWidget::clearAfterHide() {
 	destroyThemePreview();
 	_radial.stop();
 	_staticContent = QImage();
+	_staticContentRequestId = 0;
 	_themePreview = nullptr;
 	_themeApply.destroyDelayed();
 	_themeCancel.destroyDelayed();
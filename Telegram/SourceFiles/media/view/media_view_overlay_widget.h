@@ -27,6 +27,14 @@ class PhotoMedia;
 class DocumentMedia;
 } // namespace Data
 
+namespace Core {
+class FileLocation;
+} // namespace Core
+
+namespace Images {
+struct ReadArgs;
+} // namespace Images
+
 namespace Ui {
 class PopupMenu;
 class LinkButton;
@@ -417,12 +425,16 @@ private:
 	[[nodiscard]] Streaming::FrameWithInfo videoFrameWithInfo() const; // YUV
 	[[nodiscard]] int streamedIndex() const;
 	[[nodiscard]] QImage transformedShownContent() const;
+	[[nodiscard]] QImage fullStaticContent() const;
 	[[nodiscard]] QImage transformShownContent(
 		QImage content,
 		int rotation) const;
 	[[nodiscard]] bool documentContentShown() const;
 	[[nodiscard]] bool documentBubbleShown() const;
 	void setStaticContent(QImage image);
+	void initStaticContent(
+		Images::ReadArgs &&args,
+		Core::FileLocation location);
 	[[nodiscard]] bool contentShown() const;
 	[[nodiscard]] bool opaqueContentShown() const;
 	void clearStreaming(bool savePosition = true);
@@ -490,6 +502,8 @@ private:
 	bool _pressed = false;
 	int32 _dragging = 0;
 	QImage _staticContent;
+	QSize _staticContentSize;
+	uint64 _staticContentRequestId = 0;
 	bool _staticContentTransparent = false;
 	bool _blurred = true;
 
@@ -34,6 +34,11 @@ constexpr auto kMinConnectedTimeout = crl::time(1000);
 constexpr auto kMaxConnectedTimeout = crl::time(8000);
 constexpr auto kMinReceiveTimeout = crl::time(4000);
 constexpr auto kMaxReceiveTimeout = crl::time(64000);
+
+// Parallel upload sessions share the bandwidth, so each of them waits
+// longer. It matches the two sessions that every upload starts with,
+// not kUploadSessionsCount, which only grows on a saturated connection.
+constexpr auto kUploadReceiveTimeoutMultiplier = 2;
 constexpr auto kMarkConnectionOldTimeout = crl::time(192000);
 constexpr auto kPingDelayDisconnect = 60;
 constexpr auto kPingSendAfter = 30 * crl::time(1000);
@@ -1111,7 +1116,7 @@ void SessionPrivate::onSentSome(uint64 size) {
 			}
 		}
 		if (isUploadDcId(_shiftedDcId)) {
-			remain *= kUploadSessionsCount;
+			remain *= kUploadReceiveTimeoutMultiplier;
 		}
 		_waitForReceivedTimer.callOnce(remain);
 	}
@@ -21,13 +21,23 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/file_location.h"
 #include "core/mime_type.h"
 #include "main/main_session.h"
+#include "base/unixtime.h"
 #include "apiwrap.h"
 
+#include <QtCore/QDataStream>
+#include <QtCore/QFileInfo>
+
 namespace Storage {
 namespace {
 
-// max 512kb uploaded at the same time in each session
-constexpr auto kMaxUploadFileParallelSize = MTP::kUploadSessionsCount * 512 * 1024;
+// max 1mb uploaded at the same time in each session
+constexpr auto kMaxUploadPerSession = 1024 * 1024;
+
+// Start with two sessions, add more while they stay saturated
+// and remove them again when parts stop waiting for a free session.
+constexpr auto kStartUploadSessionsCount = 2;
+constexpr auto kAddSessionSuccesses = 8;
+constexpr auto kRemoveSessionSuccesses = 16;
 
 constexpr auto kDocumentMaxPartsCountDefault = 4000;
 
@@ -52,6 +62,69 @@ constexpr auto kUploadRequestInterval = crl::time(500);
 // How much time without upload causes additional session kill.
 constexpr auto kKillSessionTimeout = 15 * crl::time(000);
 
+// Big file uploads remember acknowledged parts, so that sending
+// the same file again continues where the previous attempt stopped.
+constexpr auto kResumeStateVersion = qint32(1);
+constexpr auto kResumeSaveEachParts = 32;
+constexpr auto kResumeStateLifetime = TimeId(12 * 3600);
+
+struct ResumeState {
+	uint64 fileId = 0;
+	int32 partSize = 0;
+	int32 partsCount = 0;
+	int32 ackedParts = 0;
+	TimeId saved = 0;
+};
+
+[[nodiscard]] QByteArray SerializeResumeState(const ResumeState &state) {
+	auto result = QByteArray();
+	{
+		auto stream = QDataStream(&result, QIODevice::WriteOnly);
+		stream.setVersion(QDataStream::Qt_5_1);
+		stream
+			<< kResumeStateVersion
+			<< quint64(state.fileId)
+			<< qint32(state.partSize)
+			<< qint32(state.partsCount)
+			<< qint32(state.ackedParts)
+			<< qint32(state.saved);
+	}
+	return result;
+}
+
+[[nodiscard]] std::optional<ResumeState> DeserializeResumeState(
+		const QByteArray &serialized) {
+	if (serialized.isEmpty()) {
+		return std::nullopt;
+	}
+	auto stream = QDataStream(serialized);
+	stream.setVersion(QDataStream::Qt_5_1);
+	auto version = qint32();
+	auto fileId = quint64();
+	auto partSize = qint32();
+	auto partsCount = qint32();
+	auto ackedParts = qint32();
+	auto saved = qint32();
+	stream
+		>> version
+		>> fileId
+		>> partSize
+		>> partsCount
+		>> ackedParts
+		>> saved;
+	if (stream.status() != QDataStream::Ok
+		|| version != kResumeStateVersion) {
+		return std::nullopt;
+	}
+	return ResumeState{
+		.fileId = fileId,
+		.partSize = partSize,
+		.partsCount = partsCount,
+		.ackedParts = ackedParts,
+		.saved = saved,
+	};
+}
+
 [[nodiscard]] const char *ThumbnailFormat(const QString &mime) {
 	return Core::IsMimeSticker(mime) ? "WEBP" : "JPG";
 }
@@ -71,9 +144,12 @@ struct Uploader::File {
 	mutable int64 fileSentSize = 0;
 
 	uint64 id() const;
+	uint64 uploadFileId() const;
 	SendMediaType type() const;
 	uint64 thumbId() const;
 	const QString &filename() const;
+	const QString &filepath() const;
+	bool resumable() const;
 
 	HashMd5 md5Hash;
 
@@ -83,6 +159,13 @@ struct Uploader::File {
 	int docSentParts = 0;
 	int docPartsCount = 0;
 
+	std::optional<Storage::Cache::Key> resumeKey;
+	uint64 resumedFileId = 0;
+	bool resumeChecking = false;
+	int docAckedParts = 0;
+	int docSavedParts = 0;
+	base::flat_set<int> docAckedAbove;
+
 };
 
 Uploader::File::File(const SendMediaReady &media) : media(media) {
@@ -116,7 +199,10 @@ void Uploader::File::setDocSize(int64 size) {
 	docSize = size;
 	constexpr auto limit0 = 1024 * 1024;
 	constexpr auto limit1 = 32 * limit0;
-	if (docSize >= limit0 || !setPartSize(kDocumentUploadPartSize0)) {
+	if (docSize > kUseBigFilesFrom) {
+		// Big files go with the largest parts, fewer requests are better.
+		setPartSize(kDocumentUploadPartSize4);
+	} else if (docSize >= limit0 || !setPartSize(kDocumentUploadPartSize0)) {
 		if (docSize > limit1 || !setPartSize(kDocumentUploadPartSize1)) {
 			if (!setPartSize(kDocumentUploadPartSize2)) {
 				if (!setPartSize(kDocumentUploadPartSize3)) {
@@ -138,6 +224,10 @@ uint64 Uploader::File::id() const {
 	return file ? file->id : media.id;
 }
 
+uint64 Uploader::File::uploadFileId() const {
+	return resumedFileId ? resumedFileId : id();
+}
+
 SendMediaType Uploader::File::type() const {
 	return file ? file->type : media.type;
 }
@@ -150,10 +240,26 @@ const QString &Uploader::File::filename() const {
 	return file ? file->filename : media.filename;
 }
 
+const QString &Uploader::File::filepath() const {
+	return file ? file->filepath : media.file;
+}
+
+bool Uploader::File::resumable() const {
+	const auto &content = file ? file->content : media.data;
+	return (type() == SendMediaType::File
+		|| type() == SendMediaType::ThemeFile
+		|| type() == SendMediaType::Audio)
+		&& (docSize > kUseBigFilesFrom)
+		&& content.isEmpty()
+		&& !filepath().isEmpty();
+}
+
 Uploader::Uploader(not_null<ApiWrap*> api)
 : _api(api)
 , _nextTimer([=] { sendNext(); })
 , _stopSessionsTimer([=] { stopSessions(); }) {
+	resetSessionsCount();
+
 	const auto session = &_api->session();
 	photoReady(
 	) | rpl::start_with_next([=](UploadedMedia &&data) {
@@ -299,7 +405,8 @@ void Uploader::uploadMedia(
 			document->setLocation(Core::FileLocation(media.file));
 		}
 	}
-	queue.emplace(msgId, File(media));
+	const auto i = queue.emplace(msgId, File(media)).first;
+	checkResumeState(i->first, i->second);
 	sendNext();
 }
 
@@ -350,10 +457,108 @@ void Uploader::upload(
 			document->checkWallPaperProperties();
 		}
 	}
-	queue.emplace(msgId, File(file));
+	const auto i = queue.emplace(msgId, File(file)).first;
+	checkResumeState(i->first, i->second);
+	sendNext();
+}
+
+void Uploader::checkResumeState(const FullMsgId &msgId, File &file) {
+	if (!file.resumable()) {
+		return;
+	}
+	const auto info = QFileInfo(file.filepath());
+	if (info.size() != file.docSize) {
+		return;
+	}
+	const auto key = Data::UploadStateCacheKey(
+		file.filepath(),
+		file.docSize,
+		info.lastModified());
+	const auto claimed = ranges::any_of(queue, [&](const auto &pair) {
+		return (pair.second.resumeKey == key);
+	});
+	if (claimed) {
+		// The same file is already queued, only that upload may resume
+		// from the saved state and save it, this one starts from zero.
+		return;
+	}
+	file.resumeKey = key;
+	file.resumeChecking = true;
+	session().data().cache().get(*file.resumeKey, [=](QByteArray &&value) {
+		crl::on_main(this, [=, value = std::move(value)] {
+			applyResumeState(msgId, value);
+		});
+	});
+}
+
+void Uploader::applyResumeState(
+		const FullMsgId &msgId,
+		const QByteArray &serialized) {
+	const auto i = queue.find(msgId);
+	if (i == queue.end() || !i->second.resumeChecking) {
+		return;
+	}
+	auto &file = i->second;
+	file.resumeChecking = false;
+	const auto state = DeserializeResumeState(serialized);
+	if (state
+		&& state->fileId != 0
+		&& state->partSize == file.docPartSize
+		&& state->partsCount == file.docPartsCount
+		&& state->ackedParts > 0
+		&& state->ackedParts < file.docPartsCount
+		&& (base::unixtime::now() - state->saved) < kResumeStateLifetime
+		&& !file.docSentParts) {
+		file.resumedFileId = state->fileId;
+		file.docSentParts = file.docAckedParts
+			= file.docSavedParts
+			= state->ackedParts;
+
+		const auto document = session().data().document(file.id());
+		if (document->uploading()) {
+			document->uploadingData->offset = std::min(
+				document->uploadingData->size,
+				file.docSentParts * file.docPartSize);
+		}
+	}
 	sendNext();
 }
 
+void Uploader::partAcknowledged(File &file, int part) {
+	if (!file.resumeKey) {
+		return;
+	} else if (part != file.docAckedParts) {
+		file.docAckedAbove.emplace(part);
+		return;
+	}
+	++file.docAckedParts;
+	while (!file.docAckedAbove.empty()
+		&& file.docAckedAbove.front() == file.docAckedParts) {
+		file.docAckedAbove.erase(file.docAckedAbove.begin());
+		++file.docAckedParts;
+	}
+	if (file.docAckedParts < file.docPartsCount
+		&& (file.docAckedParts - file.docSavedParts
+			>= kResumeSaveEachParts)) {
+		file.docSavedParts = file.docAckedParts;
+		session().data().cache().put(
+			*file.resumeKey,
+			SerializeResumeState({
+				.fileId = file.uploadFileId(),
+				.partSize = int32(file.docPartSize),
+				.partsCount = file.docPartsCount,
+				.ackedParts = file.docAckedParts,
+				.saved = base::unixtime::now(),
+			}));
+	}
+}
+
+void Uploader::clearResumeState(File &file) {
+	if (const auto key = base::take(file.resumeKey)) {
+		session().data().cache().remove(*key);
+	}
+}
+
 void Uploader::currentFailed() {
 	auto j = queue.find(uploadingId);
 	if (j != queue.end()) {
@@ -369,6 +574,7 @@ void Uploader::currentFailed() {
 	for (int i = 0; i < MTP::kUploadSessionsCount; ++i) {
 		sentSizes[i] = 0;
 	}
+	resetSessionsCount();
 
 	sendNext();
 }
@@ -396,10 +602,21 @@ void Uploader::stopSessions() {
 	for (int i = 0; i < MTP::kUploadSessionsCount; ++i) {
 		_api->instance().stopSession(MTP::uploadDcId(i));
 	}
+	resetSessionsCount();
+}
+
+void Uploader::resetSessionsCount() {
+	_sessionsCount = kStartUploadSessionsCount;
+	_saturatedSuccesses = 0;
+	_unsaturatedSuccesses = 0;
+	_saturated = false;
 }
 
 void Uploader::sendNext() {
-	if (sentSize >= kMaxUploadFileParallelSize || _pausedId.msg) {
+	if (_pausedId.msg) {
+		return;
+	} else if (sentSize >= uint32(_sessionsCount * kMaxUploadPerSession)) {
+		_saturated = true;
 		return;
 	}
 
@@ -422,9 +639,12 @@ void Uploader::sendNext() {
 		uploadingId = i->first;
 	}
 	auto &uploadingData = i->second;
+	if (uploadingData.resumeChecking) {
+		return;
+	}
 
 	auto todc = 0;
-	for (auto dc = 1; dc != MTP::kUploadSessionsCount; ++dc) {
+	for (auto dc = 1; dc != _sessionsCount; ++dc) {
 		if (sentSizes[dc] < sentSizes[todc]) {
 			todc = dc;
 		}
@@ -486,7 +706,7 @@ void Uploader::sendNext() {
 
 					const auto file = (uploadingData.docSize > kUseBigFilesFrom)
 						? MTP_inputFileBig(
-							MTP_long(uploadingData.id()),
+							MTP_long(uploadingData.uploadFileId()),
 							MTP_int(uploadingData.docPartsCount),
 							MTP_string(uploadingData.filename()))
 						: MTP_inputFile(
@@ -510,6 +730,7 @@ void Uploader::sendNext() {
 							MTP_string(thumbFilename),
 							MTP_bytes(thumbMd5));
 					}();
+					clearResumeState(uploadingData);
 					_documentReady.fire({
 						.fullId = uploadingId,
 						.info = {
@@ -539,13 +760,17 @@ void Uploader::sendNext() {
 		QByteArray toSend;
 		if (content.isEmpty()) {
 			if (!uploadingData.docFile) {
-				const auto filepath = uploadingData.file
-					? uploadingData.file->filepath
-					: uploadingData.media.file;
-				uploadingData.docFile = std::make_unique<QFile>(filepath);
+				uploadingData.docFile = std::make_unique<QFile>(
+					uploadingData.filepath());
 				if (!uploadingData.docFile->open(QIODevice::ReadOnly)) {
 					currentFailed();
 					return;
+				} else if (uploadingData.docSentParts > 0
+					&& !uploadingData.docFile->seek(
+						uploadingData.docSentParts
+							* uploadingData.docPartSize)) {
+					currentFailed();
+					return;
 				}
 			}
 			toSend = uploadingData.docFile->read(uploadingData.docPartSize);
@@ -572,7 +797,7 @@ void Uploader::sendNext() {
 		mtpRequestId requestId;
 		if (uploadingData.docSize > kUseBigFilesFrom) {
 			requestId = _api->request(MTPupload_SaveBigFilePart(
-				MTP_long(uploadingData.id()),
+				MTP_long(uploadingData.uploadFileId()),
 				MTP_int(uploadingData.docSentParts),
 				MTP_int(uploadingData.docPartsCount),
 				MTP_bytes(toSend)
@@ -678,6 +903,7 @@ void Uploader::clear() {
 		_api->instance().stopSession(MTP::uploadDcId(i));
 		sentSizes[i] = 0;
 	}
+	resetSessionsCount();
 	_stopSessionsTimer.cancel();
 }
 
@@ -701,6 +927,7 @@ void Uploader::partLoaded(const MTPBool &result, mtpRequestId requestId) {
 			dcMap.erase(dcIt);
 
 			int64 sentPartSize = 0;
+			auto docPart = -1;
 			auto k = queue.find(uploadingId);
 			Assert(k != queue.cend());
 			auto &[fullId, file] = *k;
@@ -709,10 +936,24 @@ void Uploader::partLoaded(const MTPBool &result, mtpRequestId requestId) {
 				requestsSent.erase(i);
 			} else {
 				sentPartSize = file.docPartSize;
+				docPart = j->second;
 				docRequestsSent.erase(j);
 			}
 			sentSize -= sentPartSize;
 			sentSizes[dc] -= sentPartSize;
+			if (std::exchange(_saturated, false)) {
+				_unsaturatedSuccesses = 0;
+				if (++_saturatedSuccesses >= kAddSessionSuccesses
+					&& _sessionsCount < MTP::kUploadSessionsCount) {
+					++_sessionsCount;
+					_saturatedSuccesses = 0;
+				}
+			} else if (++_unsaturatedSuccesses >= kRemoveSessionSuccesses) {
+				_saturatedSuccesses = _unsaturatedSuccesses = 0;
+				if (_sessionsCount > kStartUploadSessionsCount) {
+					--_sessionsCount;
+				}
+			}
 			if (file.type() == SendMediaType::Photo) {
 				file.fileSentSize += sentPartSize;
 				const auto photo = session().data().photo(file.id());
@@ -724,6 +965,9 @@ void Uploader::partLoaded(const MTPBool &result, mtpRequestId requestId) {
 			} else if (file.type() == SendMediaType::File
 				|| file.type() == SendMediaType::ThemeFile
 				|| file.type() == SendMediaType::Audio) {
+				if (docPart >= 0) {
+					partAcknowledged(file, docPart);
+				}
 				const auto document = session().data().document(file.id());
 				if (document->uploading()) {
 					const auto doneParts = file.docSentParts
@@ -113,9 +113,17 @@ private:
 	void processDocumentProgress(const FullMsgId &msgId);
 	void processDocumentFailed(const FullMsgId &msgId);
 
+	void checkResumeState(const FullMsgId &msgId, File &file);
+	void applyResumeState(
+		const FullMsgId &msgId,
+		const QByteArray &serialized);
+	void partAcknowledged(File &file, int part);
+	void clearResumeState(File &file);
+
 	void notifyFailed(FullMsgId id, const File &file);
 	void currentFailed();
 	void cancelRequests();
+	void resetSessionsCount();
 
 	void sendProgressUpdate(
 		not_null<HistoryItem*> item,
@@ -128,6 +136,10 @@ private:
 	base::flat_map<mtpRequestId, int32> dcMap;
 	uint32 sentSize = 0; // FileSize: Right now any file size fits 32 bit.
 	uint32 sentSizes[MTP::kUploadSessionsCount] = { 0 };
+	int _sessionsCount = 0;
+	int _saturatedSuccesses = 0;
+	int _unsaturatedSuccesses = 0;
+	bool _saturated = false;
 
 	FullMsgId uploadingId;
 	FullMsgId _pausedId;
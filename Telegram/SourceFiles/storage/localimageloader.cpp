@@ -40,12 +40,17 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <QtGui/QImageWriter>
 #include <QtGui/QColorSpace>
 
+#include <deque>
+#include <mutex>
+
 namespace {
 
 constexpr auto kThumbnailQuality = 87;
 constexpr auto kThumbnailSize = 320;
 constexpr auto kPhotoUploadPartSize = 32 * 1024;
 constexpr auto kRecompressAfterBpp = 4;
+constexpr auto kMediaInformationCacheSize = 64;
+constexpr auto kMediaInformationCacheBytes = 64 * 1024 * 1024;
 
 using Ui::ValidateThumbDimensions;
 
@@ -168,6 +173,122 @@ struct PreparedFileThumbnail {
 	}) | ranges::to_vector;
 }
 
+struct MediaInformationKey {
+	QString filepath;
+	int64 size = 0;
+	qint64 modified = 0;
+
+	bool operator==(const MediaInformationKey &other) const {
+		return (filepath == other.filepath)
+			&& (size == other.size)
+			&& (modified == other.modified);
+	}
+};
+
+struct MediaInformationEntry {
+	MediaInformationKey key;
+	QString filemime;
+	std::variant<
+		v::null_t,
+		Ui::PreparedFileInformation::Song,
+		Ui::PreparedFileInformation::Video> media;
+	int64 bytes = 0;
+};
+
+// Sending the same local file again decodes its song cover or its video
+// first frame again, so remember them while the file stays unchanged.
+class MediaInformationCache final {
+public:
+	[[nodiscard]] std::unique_ptr<Ui::PreparedFileInformation> find(
+		const MediaInformationKey &key,
+		const QString &filemime);
+	void remember(
+		MediaInformationKey &&key,
+		const QString &filemime,
+		const Ui::PreparedFileInformation &information);
+	void clear();
+
+private:
+	std::mutex _mutex;
+	std::deque<MediaInformationEntry> _entries;
+	int64 _bytes = 0;
+
+};
+
+std::unique_ptr<Ui::PreparedFileInformation> MediaInformationCache::find(
+		const MediaInformationKey &key,
+		const QString &filemime) {
+	auto lock = std::unique_lock(_mutex);
+	const auto i = ranges::find(_entries, key, &MediaInformationEntry::key);
+	if (i == end(_entries)) {
+		return nullptr;
+	}
+	auto result = std::make_unique<Ui::PreparedFileInformation>();
+	result->filemime = (i->filemime.isEmpty() ? filemime : i->filemime);
+	v::match(i->media, [&](const auto &media) {
+		result->media = media;
+	});
+	return result;
+}
+
+void MediaInformationCache::remember(
+		MediaInformationKey &&key,
+		const QString &filemime,
+		const Ui::PreparedFileInformation &information) {
+	auto entry = MediaInformationEntry{
+		.key = std::move(key),
+		.filemime = (information.filemime != filemime)
+			? information.filemime
+			: QString(),
+	};
+	using Song = Ui::PreparedFileInformation::Song;
+	using Video = Ui::PreparedFileInformation::Video;
+	if (const auto song = std::get_if<Song>(&information.media)) {
+		entry.media = *song;
+		entry.bytes = song->cover.sizeInBytes();
+	} else if (const auto video = std::get_if<Video>(&information.media)) {
+		entry.media = *video;
+		entry.bytes = video->thumbnail.sizeInBytes();
+	} else {
+		return;
+	}
+
+	// Video first frames are kept in full size, don't let them pile up.
+	const auto fits = (entry.bytes <= kMediaInformationCacheBytes / 4);
+
+	auto lock = std::unique_lock(_mutex);
+	const auto i = ranges::find(
+		_entries,
+		entry.key,
+		&MediaInformationEntry::key);
+	if (i != end(_entries)) {
+		_bytes -= i->bytes;
+		_entries.erase(i);
+	}
+	if (!fits) {
+		return;
+	}
+	while (!_entries.empty()
+		&& (_entries.size() >= kMediaInformationCacheSize
+			|| _bytes + entry.bytes > kMediaInformationCacheBytes)) {
+		_bytes -= _entries.front().bytes;
+		_entries.pop_front();
+	}
+	_bytes += entry.bytes;
+	_entries.push_back(std::move(entry));
+}
+
+void MediaInformationCache::clear() {
+	auto lock = std::unique_lock(_mutex);
+	_entries.clear();
+	_bytes = 0;
+}
+
+[[nodiscard]] MediaInformationCache &MediaInformation() {
+	static auto result = MediaInformationCache();
+	return result;
+}
+
 [[nodiscard]] QByteArray ComputePhotoJpegBytes(
 		QImage &full,
 		const QByteArray &bytes,
@@ -570,12 +691,30 @@ auto FileLoadTask::ReadMediaInformation(
 	const QByteArray &content,
 	const QString &filemime)
 -> std::unique_ptr<Ui::PreparedFileInformation> {
+	const auto info = (content.isEmpty() && !filepath.isEmpty())
+		? QFileInfo(filepath)
+		: QFileInfo();
+	auto key = info.exists()
+		? std::make_optional(MediaInformationKey{
+			.filepath = filepath,
+			.size = info.size(),
+			.modified = info.lastModified().toMSecsSinceEpoch(),
+		})
+		: std::nullopt;
+	if (key) {
+		if (auto cached = MediaInformation().find(*key, filemime)) {
+			return cached;
+		}
+	}
+
 	auto result = std::make_unique<Ui::PreparedFileInformation>();
 	result->filemime = filemime;
 
-	if (CheckForSong(filepath, content, result)) {
-		return result;
-	} else if (CheckForVideo(filepath, content, result)) {
+	if (CheckForSong(filepath, content, result)
+		|| CheckForVideo(filepath, content, result)) {
+		if (key) {
+			MediaInformation().remember(std::move(*key), filemime, *result);
+		}
 		return result;
 	} else if (CheckForImage(filepath, content, result)) {
 		return result;
@@ -583,6 +722,10 @@ auto FileLoadTask::ReadMediaInformation(
 	return result;
 }
 
+void FileLoadTask::ClearMediaInformationCache() {
+	MediaInformation().clear();
+}
+
 template <typename Mimes, typename Extensions>
 bool FileLoadTask::CheckMimeOrExtensions(
 		const QString &filepath,
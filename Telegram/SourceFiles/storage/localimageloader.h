@@ -264,6 +264,7 @@ public:
 		const QString &filepath,
 		const QByteArray &content,
 		const QString &filemime);
+	static void ClearMediaInformationCache();
 	static bool FillImageInformation(
 		QImage &&image,
 		bool animated,
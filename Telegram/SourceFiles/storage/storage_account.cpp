@@ -26,6 +26,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/core_settings.h"
 #include "core/file_location.h"
+#include "core/startup_trace.h"
 #include "data/stickers/data_stickers.h"
 #include "data/data_session.h"
 #include "data/data_document.h"
@@ -33,6 +34,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_drafts.h"
 #include "export/export_settings.h"
 #include "window/themes/window_theme.h"
+#include "base/crc32hash.h"
 
 namespace Storage {
 namespace {
@@ -43,8 +45,10 @@ using Database = Cache::Database;
 constexpr auto kDelayedWriteTimeout = crl::time(1000);
 
 constexpr auto kStickersVersionTag = quint32(-1);
-constexpr auto kStickersSerializeVersion = 2;
+constexpr auto kStickersSerializeVersion = 3;
+constexpr auto kStickersInlineSerializeVersion = 2;
 constexpr auto kMaxSavedStickerSetsCount = 1000;
+constexpr auto kStickerSetFilesCount = 8;
 constexpr auto kDefaultStickerInstallDate = TimeId(1);
 
 constexpr auto kSinglePeerTypeUserOld = qint32(1);
@@ -104,6 +108,75 @@ auto EmptyMessageDraftSources()
 	return dataNameHash[0];
 }
 
+[[nodiscard]] quint32 StickerSetSize(const Data::StickersSet &set) {
+	// id + accessHash + hash + title + shortName + stickersCount + flags + installDate
+	auto result = quint32(sizeof(quint64) * 3
+		+ Serialize::stringSize(set.title)
+		+ Serialize::stringSize(set.shortName)
+		+ sizeof(qint32) * 3
+		+ Serialize::imageLocationSize(set.thumbnailLocation()));
+	if (set.flags & Data::StickersSetFlag::NotLoaded) {
+		return result;
+	}
+
+	for (const auto sticker : std::as_const(set.stickers)) {
+		result += Serialize::Document::sizeInStream(sticker);
+	}
+
+	result += sizeof(qint32); // datesCount
+	if (!set.dates.empty()) {
+		Assert(set.stickers.size() == set.dates.size());
+		result += set.dates.size() * sizeof(qint32);
+	}
+
+	result += sizeof(qint32); // emojiCount
+	for (auto j = set.emoji.cbegin(), e = set.emoji.cend(); j != e; ++j) {
+		result += Serialize::stringSize(j.key()->id())
+			+ sizeof(qint32)
+			+ (j->size() * sizeof(quint64));
+	}
+	return result;
+}
+
+[[nodiscard]] int StickerSetFileIndex(uint64 setId) {
+	return int(setId % kStickerSetFilesCount);
+}
+
+[[nodiscard]] FileKey StickerSetFileKey(FileKey stickersKey, int index) {
+	// Derived from the list key, so they're found even without the index.
+	return stickersKey + FileKey(index + 1);
+}
+
+[[nodiscard]] int32 StickerSetFingerprint(const Data::StickersSet &set) {
+	// Much cheaper than serializing all the documents of the set.
+	auto buffer = QByteArray();
+	{
+		QDataStream stream(&buffer, QIODevice::WriteOnly);
+		stream
+			<< quint64(set.id)
+			<< quint64(set.accessHash)
+			<< quint64(set.hash)
+			<< set.title
+			<< set.shortName
+			<< qint32(set.count)
+			<< qint32(set.flags)
+			<< qint32(set.installDate);
+		for (const auto sticker : std::as_const(set.stickers)) {
+			stream << quint64(sticker->id);
+		}
+		for (const auto date : set.dates) {
+			stream << qint32(date);
+		}
+		for (auto j = set.emoji.cbegin(), e = set.emoji.cend(); j != e; ++j) {
+			stream << j.key()->id() << qint32(j->size());
+			for (const auto sticker : *j) {
+				stream << quint64(sticker->id);
+			}
+		}
+	}
+	return base::crc32(buffer.constData(), buffer.size());
+}
+
 [[nodiscard]] QString BaseGlobalPath() {
 	return cWorkingDir() + qsl("tdata/");
 }
@@ -161,6 +234,8 @@ StartResult Account::legacyStart(const QByteArray &passcode) {
 std::unique_ptr<MTP::Config> Account::start(MTP::AuthKeyPtr localKey) {
 	Expects(localKey != nullptr);
 
+	const auto span = Core::StartupTrace::Span("Storage::Account::start");
+
 	_localKey = std::move(localKey);
 	readMapWith(_localKey);
 	clearLegacyFiles();
@@ -236,6 +311,7 @@ base::flat_set<QString> Account::collectGoodNames() const {
 Account::ReadMapResult Account::readMapWith(
 		MTP::AuthKeyPtr localKey,
 		const QByteArray &legacyPasscode) {
+	const auto span = Core::StartupTrace::Span("Storage::Account::readMap");
 	auto ms = crl::now();
 
 	FileReadDescriptor mapData;
@@ -593,6 +669,7 @@ void Account::reset() {
 	_installedMasksKey = 0;
 	_recentMasksKey = 0;
 	_archivedMasksKey = 0;
+	_stickerSetFiles.clear();
 	_legacyBackgroundKeyDay = _legacyBackgroundKeyNight = 0;
 	_settingsKey = _recentHashtagsAndBotsKey = _exportSettingsKey = 0;
 	_oldMapVersion = 0;
@@ -609,7 +686,11 @@ void Account::reset() {
 	writeMap();
 	writeMtpData();
 
-	crl::async([base = _basePath, temp = _tempPath, names = std::move(names)] {
+	crl::async(crl::priority::background, [
+		base = _basePath,
+		temp = _tempPath,
+		names = std::move(names)
+	] {
 		for (const auto &name : names) {
 			if (!name.endsWith(qstr("map0"))
 				&& !name.endsWith(qstr("map1"))
@@ -618,6 +699,7 @@ void Account::reset() {
 				QFile::remove(base + name);
 			}
 		}
+		QDir(base + qsl("stickers")).removeRecursively();
 		QDir(LegacyTempDirectory()).removeRecursively();
 		QDir(temp).removeRecursively();
 	});
@@ -1653,19 +1735,8 @@ void Account::writeStickerSets(
 	using SetFlag = Data::StickersSetFlag;
 
 	const auto &sets = _owner->session().data().stickers().sets();
-	if (sets.empty()) {
-		if (stickersKey) {
-			ClearKey(stickersKey, _basePath);
-			stickersKey = 0;
-			writeMapDelayed();
-		}
-		return;
-	}
-
-	// versionTag + version + count
-	quint32 size = sizeof(quint32) + sizeof(qint32) + sizeof(qint32);
-
-	int32 setsCount = 0;
+	auto writing = std::vector<not_null<Data::StickersSet*>>();
+	writing.reserve(sets.size());
 	for (const auto &[id, set] : sets) {
 		const auto raw = set.get();
 		auto result = checkSet(*raw);
@@ -1673,62 +1744,83 @@ void Account::writeStickerSets(
 			return;
 		} else if (result == StickerSetCheckResult::Skip) {
 			continue;
-		}
-
-		// id + accessHash + hash + title + shortName + stickersCount + flags + installDate
-		size += sizeof(quint64) * 3
-			+ Serialize::stringSize(raw->title)
-			+ Serialize::stringSize(raw->shortName)
-			+ sizeof(qint32) * 3
-			+ Serialize::imageLocationSize(raw->thumbnailLocation());
-		if (raw->flags & SetFlag::NotLoaded) {
+		} else if (raw->stickers.isEmpty()
+			&& !(raw->flags & SetFlag::NotLoaded)) {
+			// Nothing is written for such sets.
 			continue;
 		}
-
-		for (const auto sticker : std::as_const(raw->stickers)) {
-			size += Serialize::Document::sizeInStream(sticker);
-		}
-
-		size += sizeof(qint32); // datesCount
-		if (!raw->dates.empty()) {
-			Assert(raw->stickers.size() == raw->dates.size());
-			size += raw->dates.size() * sizeof(qint32);
-		}
-
-		size += sizeof(qint32); // emojiCount
-		for (auto j = raw->emoji.cbegin(), e = raw->emoji.cend(); j != e; ++j) {
-			size += Serialize::stringSize(j.key()->id()) + sizeof(qint32) + (j->size() * sizeof(quint64));
-		}
-
-		++setsCount;
+		writing.push_back(raw);
 	}
-	if (!setsCount && order.isEmpty()) {
+	if (writing.empty() && order.isEmpty()) {
 		if (stickersKey) {
+			clearStickerSetFiles(stickersKey);
 			ClearKey(stickersKey, _basePath);
 			stickersKey = 0;
 			writeMapDelayed();
 		}
 		return;
 	}
-	size += sizeof(qint32) + (order.size() * sizeof(quint64));
 
 	if (!stickersKey) {
 		stickersKey = GenerateKey(_basePath);
 		writeMapQueued();
 	}
+
+	// Sets are spread over a few files and only changed ones are rewritten.
+	auto groups = std::vector<std::vector<not_null<Data::StickersSet*>>>(
+		kStickerSetFilesCount);
+	for (const auto set : writing) {
+		groups[StickerSetFileIndex(set->id)].push_back(set);
+	}
+	const auto path = stickerSetsPath();
+	auto &checksums = _stickerSetFiles[stickersKey];
+	checksums.resize(kStickerSetFilesCount);
+	for (auto index = 0; index != kStickerSetFilesCount; ++index) {
+		const auto &group = groups[index];
+		auto fingerprints = std::vector<int32>();
+		fingerprints.reserve(group.size());
+		for (const auto set : group) {
+			fingerprints.push_back(StickerSetFingerprint(*set));
+		}
+		const auto checksum = group.empty()
+			? 0
+			: (base::crc32(
+				fingerprints.data(),
+				int(fingerprints.size() * sizeof(int32))) | 1);
+		if (checksums[index] == checksum) {
+			continue;
+		}
+		checksums[index] = checksum;
+
+		const auto key = StickerSetFileKey(stickersKey, index);
+		if (group.empty()) {
+			ClearKey(key, path);
+			continue;
+		}
+		auto size = quint32(sizeof(qint32));
+		for (const auto set : group) {
+			size += StickerSetSize(*set);
+		}
+		EncryptedDescriptor data(size);
+		data.stream << qint32(group.size());
+		for (const auto set : group) {
+			writeStickerSet(data.stream, *set);
+		}
+		FileWriteDescriptor(key, path).writeEncrypted(data, _localKey);
+	}
+
+	// versionTag + version + count + checksums + order
+	auto size = sizeof(quint32) + sizeof(qint32) + sizeof(qint32);
+	size += checksums.size() * sizeof(qint32);
+	size += sizeof(qint32) + (order.size() * sizeof(quint64));
+
 	EncryptedDescriptor data(size);
 	data.stream
 		<< quint32(kStickersVersionTag)
 		<< qint32(kStickersSerializeVersion)
-		<< qint32(setsCount);
-	for (const auto &[id, set] : sets) {
-		auto result = checkSet(*set);
-		if (result == StickerSetCheckResult::Abort) {
-			return;
-		} else if (result == StickerSetCheckResult::Skip) {
-			continue;
-		}
-		writeStickerSet(data.stream, *set);
+		<< qint32(checksums.size());
+	for (const auto checksum : checksums) {
+		data.stream << qint32(checksum);
 	}
 	data.stream << order;
 
@@ -1736,6 +1828,21 @@ void Account::writeStickerSets(
 	file.writeEncrypted(data, _localKey);
 }
 
+QString Account::stickerSetsPath() const {
+	return _basePath + qsl("stickers/");
+}
+
+void Account::clearStickerSetFiles(FileKey stickersKey) {
+	if (!stickersKey) {
+		return;
+	}
+	const auto path = stickerSetsPath();
+	for (auto index = 0; index != kStickerSetFilesCount; ++index) {
+		ClearKey(StickerSetFileKey(stickersKey, index), path);
+	}
+	_stickerSetFiles.remove(stickersKey);
+}
+
 void Account::readStickerSets(
 		FileKey &stickersKey,
 		Data::StickersSetsOrder *outOrder,
@@ -1744,6 +1851,7 @@ void Account::readStickerSets(
 
 	FileReadDescriptor stickers;
 	if (!ReadEncryptedFile(stickers, stickersKey, _basePath, _localKey)) {
+		clearStickerSetFiles(stickersKey);
 		ClearKey(stickersKey, _basePath);
 		stickersKey = 0;
 		writeMapDelayed();
@@ -1751,6 +1859,7 @@ void Account::readStickerSets(
 	}
 
 	const auto failed = [&] {
+		clearStickerSetFiles(stickersKey);
 		ClearKey(stickersKey, _basePath);
 		stickersKey = 0;
 	};
@@ -1762,7 +1871,8 @@ void Account::readStickerSets(
 	qint32 version = 0;
 	stickers.stream >> versionTag >> version;
 	if (versionTag != kStickersVersionTag
-		|| version != kStickersSerializeVersion) {
+		|| (version != kStickersSerializeVersion
+			&& version != kStickersInlineSerializeVersion)) {
 		// Old data, without sticker set thumbnails.
 		return failed();
 	}
@@ -1773,165 +1883,51 @@ void Account::readStickerSets(
 		|| (count > kMaxSavedStickerSetsCount)) {
 		return failed();
 	}
-	for (auto i = 0; i != count; ++i) {
-		quint64 setId = 0, setAccessHash = 0, setHash = 0;
-		QString setTitle, setShortName;
-		qint32 scnt = 0;
-		qint32 setInstallDate = 0;
-		Data::StickersSetFlags setFlags = 0;
-		qint32 setFlagsValue = 0;
-		ImageLocation setThumbnail;
-
-		stickers.stream
-			>> setId
-			>> setAccessHash
-			>> setHash
-			>> setTitle
-			>> setShortName
-			>> scnt
-			>> setFlagsValue
-			>> setInstallDate;
-		const auto thumbnail = Serialize::readImageLocation(
-			stickers.version,
-			stickers.stream);
-		if (!thumbnail || !CheckStreamStatus(stickers.stream)) {
-			return failed();
-		} else if (thumbnail->valid() && thumbnail->isLegacy()) {
-			// No thumb_version information in legacy location.
-			return failed();
-		} else {
-			setThumbnail = *thumbnail;
-		}
-
-		setFlags = Data::StickersSetFlags::from_raw(setFlagsValue);
-		if (setId == Data::Stickers::DefaultSetId) {
-			setTitle = tr::lng_stickers_default_set(tr::now);
-			setFlags |= SetFlag::Official | SetFlag::Special;
-		} else if (setId == Data::Stickers::CustomSetId) {
-			setTitle = qsl("Custom stickers");
-			setFlags |= SetFlag::Special;
-		} else if ((setId == Data::Stickers::CloudRecentSetId)
-				|| (setId == Data::Stickers::CloudRecentAttachedSetId)) {
-			setTitle = tr::lng_recent_stickers(tr::now);
-			setFlags |= SetFlag::Special;
-		} else if (setId == Data::Stickers::FavedSetId) {
-			setTitle = Lang::Hard::FavedSetTitle();
-			setFlags |= SetFlag::Special;
-		} else if (!setId) {
-			continue;
-		}
-
-		auto it = sets.find(setId);
-		if (it == sets.cend()) {
-			// We will set this flags from order lists when reading those stickers.
-			setFlags &= ~(SetFlag::Installed | SetFlag::Featured);
-			it = sets.emplace(setId, std::make_unique<Data::StickersSet>(
-				&_owner->session().data(),
-				setId,
-				setAccessHash,
-				setHash,
-				setTitle,
-				setShortName,
-				0,
-				setFlags,
-				setInstallDate)).first;
-			it->second->setThumbnail(
-				ImageWithLocation{ .location = setThumbnail });
-		}
-		const auto set = it->second.get();
-		const auto inputSet = set->identifier();
-		const auto fillStickers = set->stickers.isEmpty();
-
-		if (scnt < 0) { // disabled not loaded set
-			if (!set->count || fillStickers) {
-				set->count = -scnt;
-			}
-			continue;
-		}
-
-		if (fillStickers) {
-			set->stickers.reserve(scnt);
-			set->count = 0;
-		}
-
-		Serialize::Document::StickerSetInfo info(
-			setId,
-			setAccessHash,
-			setShortName);
-		base::flat_set<DocumentId> read;
-		for (int32 j = 0; j < scnt; ++j) {
-			auto document = Serialize::Document::readStickerFromStream(
-				&_owner->session(),
-				stickers.version,
-				stickers.stream, info);
-			if (!CheckStreamStatus(stickers.stream)) {
+	if (version == kStickersInlineSerializeVersion) {
+		// All sets were written to the list file itself.
+		for (auto i = 0; i != count; ++i) {
+			if (!readStickerSet(stickers)) {
 				return failed();
-			} else if (!document
-				|| !document->sticker()
-				|| read.contains(document->id)) {
-				continue;
-			}
-			read.emplace(document->id);
-			if (fillStickers) {
-				set->stickers.push_back(document);
-				if (!(set->flags & SetFlag::Special)) {
-					if (!document->sticker()->set.id) {
-						document->sticker()->set = inputSet;
-					}
-				}
-				++set->count;
 			}
 		}
-
-		qint32 datesCount = 0;
-		stickers.stream >> datesCount;
-		if (datesCount > 0) {
-			if (datesCount != scnt) {
-				return failed();
-			}
-			const auto fillDates =
-				((set->id == Data::Stickers::CloudRecentSetId)
-					|| (set->id == Data::Stickers::CloudRecentAttachedSetId))
-				&& (set->stickers.size() == datesCount);
-			if (fillDates) {
-				set->dates.clear();
-				set->dates.reserve(datesCount);
-			}
-			for (auto i = 0; i != datesCount; ++i) {
-				qint32 date = 0;
-				stickers.stream >> date;
-				if (fillDates) {
-					set->dates.push_back(TimeId(date));
-				}
-			}
+	} else if (count != kStickerSetFilesCount) {
+		return failed();
+	} else {
+		auto checksums = std::vector<int32>(count);
+		for (auto &checksum : checksums) {
+			stickers.stream >> checksum;
 		}
-
-		qint32 emojiCount = 0;
-		stickers.stream >> emojiCount;
-		if (!CheckStreamStatus(stickers.stream) || emojiCount < 0) {
+		if (!CheckStreamStatus(stickers.stream)) {
 			return failed();
 		}
-		for (int32 j = 0; j < emojiCount; ++j) {
-			QString emojiString;
-			qint32 stickersCount;
-			stickers.stream >> emojiString >> stickersCount;
-			Data::StickersPack pack;
-			pack.reserve(stickersCount);
-			for (int32 k = 0; k < stickersCount; ++k) {
-				quint64 id;
-				stickers.stream >> id;
-				const auto doc = _owner->session().data().document(id);
-				if (!doc->sticker()) continue;
-
-				pack.push_back(doc);
+		const auto path = stickerSetsPath();
+		for (auto index = 0; index != count; ++index) {
+			if (!checksums[index]) {
+				continue;
+			}
+			// A missing file will be written again with the next list write.
+			const auto key = StickerSetFileKey(stickersKey, index);
+			FileReadDescriptor file;
+			if (!ReadEncryptedFile(file, key, path, _localKey)) {
+				checksums[index] = 0;
+				continue;
+			}
+			qint32 setsCount = 0;
+			file.stream >> setsCount;
+			if (!CheckStreamStatus(file.stream)
+				|| (setsCount < 0)
+				|| (setsCount > kMaxSavedStickerSetsCount)) {
+				setsCount = 0;
+				checksums[index] = 0;
 			}
-			if (fillStickers) {
-				if (auto emoji = Ui::Emoji::Find(emojiString)) {
-					emoji = emoji->original();
-					set->emoji.insert(emoji, pack);
+			for (auto i = 0; i != setsCount; ++i) {
+				if (!readStickerSet(file)) {
+					checksums[index] = 0;
+					break;
 				}
 			}
 		}
+		_stickerSetFiles[stickersKey] = std::move(checksums);
 	}
 
 	// Read orders of installed and featured stickers.
@@ -1972,6 +1968,172 @@ void Account::readStickerSets(
 	}
 }
 
+bool Account::readStickerSet(FileReadDescriptor &stickers) {
+	using SetFlag = Data::StickersSetFlag;
+
+	auto &sets = _owner->session().data().stickers().setsRef();
+
+	quint64 setId = 0, setAccessHash = 0, setHash = 0;
+	QString setTitle, setShortName;
+	qint32 scnt = 0;
+	qint32 setInstallDate = 0;
+	Data::StickersSetFlags setFlags = 0;
+	qint32 setFlagsValue = 0;
+	ImageLocation setThumbnail;
+
+	stickers.stream
+		>> setId
+		>> setAccessHash
+		>> setHash
+		>> setTitle
+		>> setShortName
+		>> scnt
+		>> setFlagsValue
+		>> setInstallDate;
+	const auto thumbnail = Serialize::readImageLocation(
+		stickers.version,
+		stickers.stream);
+	if (!thumbnail || !CheckStreamStatus(stickers.stream)) {
+		return false;
+	} else if (thumbnail->valid() && thumbnail->isLegacy()) {
+		// No thumb_version information in legacy location.
+		return false;
+	} else {
+		setThumbnail = *thumbnail;
+	}
+
+	setFlags = Data::StickersSetFlags::from_raw(setFlagsValue);
+	if (setId == Data::Stickers::DefaultSetId) {
+		setTitle = tr::lng_stickers_default_set(tr::now);
+		setFlags |= SetFlag::Official | SetFlag::Special;
+	} else if (setId == Data::Stickers::CustomSetId) {
+		setTitle = qsl("Custom stickers");
+		setFlags |= SetFlag::Special;
+	} else if ((setId == Data::Stickers::CloudRecentSetId)
+			|| (setId == Data::Stickers::CloudRecentAttachedSetId)) {
+		setTitle = tr::lng_recent_stickers(tr::now);
+		setFlags |= SetFlag::Special;
+	} else if (setId == Data::Stickers::FavedSetId) {
+		setTitle = Lang::Hard::FavedSetTitle();
+		setFlags |= SetFlag::Special;
+	} else if (!setId) {
+		return true;
+	}
+
+	auto it = sets.find(setId);
+	if (it == sets.cend()) {
+		// We will set this flags from order lists when reading those stickers.
+		setFlags &= ~(SetFlag::Installed | SetFlag::Featured);
+		it = sets.emplace(setId, std::make_unique<Data::StickersSet>(
+			&_owner->session().data(),
+			setId,
+			setAccessHash,
+			setHash,
+			setTitle,
+			setShortName,
+			0,
+			setFlags,
+			setInstallDate)).first;
+		it->second->setThumbnail(
+			ImageWithLocation{ .location = setThumbnail });
+	}
+	const auto set = it->second.get();
+	const auto inputSet = set->identifier();
+	const auto fillStickers = set->stickers.isEmpty();
+
+	if (scnt < 0) { // disabled not loaded set
+		if (!set->count || fillStickers) {
+			set->count = -scnt;
+		}
+		return true;
+	}
+
+	if (fillStickers) {
+		set->stickers.reserve(scnt);
+		set->count = 0;
+	}
+
+	Serialize::Document::StickerSetInfo info(
+		setId,
+		setAccessHash,
+		setShortName);
+	base::flat_set<DocumentId> read;
+	for (int32 j = 0; j < scnt; ++j) {
+		auto document = Serialize::Document::readStickerFromStream(
+			&_owner->session(),
+			stickers.version,
+			stickers.stream, info);
+		if (!CheckStreamStatus(stickers.stream)) {
+			return false;
+		} else if (!document
+			|| !document->sticker()
+			|| read.contains(document->id)) {
+			continue;
+		}
+		read.emplace(document->id);
+		if (fillStickers) {
+			set->stickers.push_back(document);
+			if (!(set->flags & SetFlag::Special)) {
+				if (!document->sticker()->set.id) {
+					document->sticker()->set = inputSet;
+				}
+			}
+			++set->count;
+		}
+	}
+
+	qint32 datesCount = 0;
+	stickers.stream >> datesCount;
+	if (datesCount > 0) {
+		if (datesCount != scnt) {
+			return false;
+		}
+		const auto fillDates =
+			((set->id == Data::Stickers::CloudRecentSetId)
+				|| (set->id == Data::Stickers::CloudRecentAttachedSetId))
+			&& (set->stickers.size() == datesCount);
+		if (fillDates) {
+			set->dates.clear();
+			set->dates.reserve(datesCount);
+		}
+		for (auto i = 0; i != datesCount; ++i) {
+			qint32 date = 0;
+			stickers.stream >> date;
+			if (fillDates) {
+				set->dates.push_back(TimeId(date));
+			}
+		}
+	}
+
+	qint32 emojiCount = 0;
+	stickers.stream >> emojiCount;
+	if (!CheckStreamStatus(stickers.stream) || emojiCount < 0) {
+		return false;
+	}
+	for (int32 j = 0; j < emojiCount; ++j) {
+		QString emojiString;
+		qint32 stickersCount;
+		stickers.stream >> emojiString >> stickersCount;
+		Data::StickersPack pack;
+		pack.reserve(stickersCount);
+		for (int32 k = 0; k < stickersCount; ++k) {
+			quint64 id;
+			stickers.stream >> id;
+			const auto doc = _owner->session().data().document(id);
+			if (!doc->sticker()) continue;
+
+			pack.push_back(doc);
+		}
+		if (fillStickers) {
+			if (auto emoji = Ui::Emoji::Find(emojiString)) {
+				emoji = emoji->original();
+				set->emoji.insert(emoji, pack);
+			}
+		}
+	}
+	return CheckStreamStatus(stickers.stream);
+}
+
 void Account::writeInstalledStickers() {
 	using SetFlag = Data::StickersSetFlag;
 
@@ -2529,6 +2691,7 @@ void Account::writeExportSettings(const Export::Settings &settings) {
 		&& settings.path == check.path
 		&& settings.format == check.format
 		&& settings.availableAt == check.availableAt
+		&& settings.onlyNewMessages == check.onlyNewMessages
 		&& !settings.onlySinglePeer()) {
 		if (_exportSettingsKey) {
 			ClearKey(_exportSettingsKey, _basePath);
@@ -2543,7 +2706,7 @@ void Account::writeExportSettings(const Export::Settings &settings) {
 	}
 	quint32 size = sizeof(quint32) * 6
 		+ Serialize::stringSize(settings.path)
-		+ sizeof(qint32) * 2 + sizeof(quint64);
+		+ sizeof(qint32) * 3 + sizeof(quint64);
 	EncryptedDescriptor data(size);
 	data.stream
 		<< quint32(settings.types)
@@ -2576,6 +2739,7 @@ void Account::writeExportSettings(const Export::Settings &settings) {
 	});
 	data.stream << qint32(settings.singlePeerFrom);
 	data.stream << qint32(settings.singlePeerTill);
+	data.stream << qint32(settings.onlyNewMessages ? 1 : 0);
 
 	FileWriteDescriptor file(_exportSettingsKey, _basePath);
 	file.writeEncrypted(data, _localKey);
@@ -2598,6 +2762,7 @@ Export::Settings Account::readExportSettings() {
 	quint64 singlePeerBareId = 0;
 	quint64 singlePeerAccessHash = 0;
 	qint32 singlePeerFrom = 0, singlePeerTill = 0;
+	qint32 onlyNewMessages = 0;
 	file.stream
 		>> types
 		>> fullChats
@@ -2628,6 +2793,9 @@ Export::Settings Account::readExportSettings() {
 	if (!file.stream.atEnd()) {
 		file.stream >> singlePeerFrom >> singlePeerTill;
 	}
+	if (!file.stream.atEnd()) {
+		file.stream >> onlyNewMessages;
+	}
 	auto result = Export::Settings();
 	result.types = Export::Settings::Types::from_raw(types);
 	result.fullChats = Export::Settings::Types::from_raw(fullChats);
@@ -2668,6 +2836,7 @@ Export::Settings Account::readExportSettings() {
 	}();
 	result.singlePeerFrom = singlePeerFrom;
 	result.singlePeerTill = singlePeerTill;
+	result.onlyNewMessages = (onlyNewMessages == 1);
 	return (file.stream.status() == QDataStream::Ok && result.validate())
 		? result
 		: Export::Settings();
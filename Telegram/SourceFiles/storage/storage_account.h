@@ -235,6 +235,9 @@ private:
 		FileKey &stickersKey,
 		Data::StickersSetsOrder *outOrder = nullptr,
 		Data::StickersSetFlags readingFlags = 0);
+	[[nodiscard]] bool readStickerSet(details::FileReadDescriptor &stickers);
+	[[nodiscard]] QString stickerSetsPath() const;
+	void clearStickerSetFiles(FileKey stickersKey);
 	void importOldRecentStickers();
 
 	void readTrustedBots();
@@ -285,6 +288,9 @@ private:
 	FileKey _installedMasksKey = 0;
 	FileKey _recentMasksKey = 0;
 
+	// Checksums of sticker set files by the key of their sets list.
+	base::flat_map<FileKey, std::vector<int32>> _stickerSetFiles;
+
 	qint64 _cacheTotalSizeLimit = 0;
 	qint64 _cacheBigFileTotalSizeLimit = 0;
 	qint32 _cacheTotalTimeLimit = 0;
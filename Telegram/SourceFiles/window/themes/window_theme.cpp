@@ -373,9 +373,10 @@ bool LoadTheme(
 	return true;
 }
 
-bool InitializeFromCache(
+bool LoadThemeFromCache(
 		const QByteArray &content,
-		const Cached &cache) {
+		const Cached &cache,
+		Instance *out = nullptr) {
 	if (cache.paletteChecksum != style::palette::Checksum()) {
 		return false;
 	}
@@ -393,12 +394,18 @@ bool InitializeFromCache(
 		}
 	}
 
-	if (!style::main_palette::load(cache.colors)) {
+	if (out) {
+		if (!out->palette.load(cache.colors)) {
+			return false;
+		}
+		out->palette.finalize();
+	} else if (!style::main_palette::load(cache.colors)) {
 		return false;
+	} else {
+		Background()->saveAdjustableColors();
 	}
-	Background()->saveAdjustableColors();
 	if (!background.isNull()) {
-		applyBackground(std::move(background), cache.tiled, nullptr);
+		applyBackground(std::move(background), cache.tiled, out);
 	}
 
 	return true;
@@ -421,7 +428,7 @@ bool InitializeFromSaved(Saved &&saved) {
 
 	const auto editing = ReadEditingPalette();
 	GlobalBackground.createIfNull();
-	if (!editing && InitializeFromCache(saved.object.content, saved.cache)) {
+	if (!editing && LoadThemeFromCache(saved.object.content, saved.cache)) {
 		return true;
 	}
 
@@ -1188,6 +1195,7 @@ void ChatBackground::reapplyWithNightMode(
 
 	_nightMode = oldNightMode;
 	auto oldTileValue = (_nightMode ? _tileNightValue : _tileDayValue);
+	auto cacheUpdated = false;
 	const auto alreadyOnDisk = [&] {
 		if (read.object.content.isEmpty()) {
 			return false;
@@ -1195,14 +1203,22 @@ void ChatBackground::reapplyWithNightMode(
 		auto preview = std::make_unique<Preview>();
 		preview->object = std::move(read.object);
 		preview->instance.cached = std::move(read.cache);
-		const auto loaded = LoadTheme(
+		const auto cached = LoadThemeFromCache(
 			preview->object.content,
-			ColorizerForTheme(path),
-			std::nullopt,
-			&preview->instance.cached,
+			preview->instance.cached,
 			&preview->instance);
-		if (!loaded) {
-			return false;
+		if (!cached) {
+			// Cache is missing or stale, parse the theme and refresh it.
+			const auto loaded = LoadTheme(
+				preview->object.content,
+				ColorizerForTheme(path),
+				std::nullopt,
+				&preview->instance.cached,
+				&preview->instance);
+			if (!loaded) {
+				return false;
+			}
+			cacheUpdated = true;
 		}
 		Apply(std::move(preview));
 		return true;
@@ -1225,7 +1241,7 @@ void ChatBackground::reapplyWithNightMode(
 			}
 
 			const auto saved = std::move(GlobalApplying.data);
-			if (!alreadyOnDisk) {
+			if (!alreadyOnDisk || cacheUpdated) {
 				// First-time switch to default night mode should write it.
 				Local::writeTheme(saved);
 			}
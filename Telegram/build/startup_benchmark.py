@@ -0,0 +1,130 @@
+'''
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+'''
+import sys, os, json, shutil, subprocess, tempfile, time
+
+# Launches Telegram several times with a copy of the given working folder,
+# collects startup traces and compares span timings with a baseline.
+#
+# startup_benchmark.py <Telegram> <working folder> [runs] [baseline.json]
+#   [--save result.json]
+
+firstPaintSpan = 'Chats list paint'
+totalName = 'Total to first chats list paint'
+waitTimeout = 60
+allowedSlowdown = 1.1
+allowedSlowdownMs = 5
+
+def usage():
+  print('Usage: startup_benchmark.py <Telegram> <working folder> [runs] [baseline.json] [--save result.json]')
+  sys.exit(1)
+
+args = sys.argv[1:]
+savePath = ''
+if '--save' in args:
+  index = args.index('--save')
+  if index + 1 >= len(args):
+    usage()
+  savePath = args[index + 1]
+  del args[index:index + 2]
+if len(args) < 2:
+  usage()
+binaryPath = os.path.realpath(args[0])
+profilePath = os.path.realpath(args[1])
+runs = int(args[2]) if len(args) > 2 else 5
+baselinePath = args[3] if len(args) > 3 else ''
+
+def readTrace(path):
+  with open(path, 'r') as f:
+    events = json.load(f)['traceEvents']
+  result = {}
+  firstPaintEnd = 0
+  for event in events:
+    if event.get('ph') != 'X':
+      continue
+    name = event['name']
+    duration = event['dur'] / 1000.
+    if name == firstPaintSpan:
+      if firstPaintEnd:
+        continue
+      firstPaintEnd = (event['ts'] + event['dur']) / 1000.
+    result[name] = result.get(name, 0) + duration
+  if firstPaintEnd:
+    result[totalName] = firstPaintEnd
+  return result
+
+def launch(index):
+  folder = tempfile.mkdtemp(prefix='tdesktop_startup_')
+  try:
+    workdir = os.path.join(folder, 'workdir')
+    shutil.copytree(profilePath, workdir)
+    tracePath = os.path.join(folder, 'trace.json')
+    env = os.environ.copy()
+    env['TDESKTOP_STARTUP_TRACE'] = tracePath
+    process = subprocess.Popen(
+      [binaryPath, '-noupdate', '-workdir', workdir + os.sep],
+      env=env)
+    started = time.time()
+    while not os.path.exists(tracePath):
+      if process.poll() is not None or time.time() - started > waitTimeout:
+        break
+      time.sleep(0.1)
+    time.sleep(0.5)
+    if process.poll() is None:
+      process.terminate()
+      try:
+        process.wait(10)
+      except subprocess.TimeoutExpired:
+        process.kill()
+    if not os.path.exists(tracePath):
+      print('[ERROR] Run ' + str(index + 1) + ' did not write a startup trace.')
+      sys.exit(1)
+    return readTrace(tracePath)
+  finally:
+    shutil.rmtree(folder, ignore_errors=True)
+
+def median(values):
+  values = sorted(values)
+  middle = len(values) // 2
+  if len(values) % 2:
+    return values[middle]
+  return (values[middle - 1] + values[middle]) / 2.
+
+samples = {}
+for index in range(runs):
+  print('Run ' + str(index + 1) + ' of ' + str(runs) + '...')
+  for name, value in launch(index).items():
+    samples.setdefault(name, []).append(value)
+
+result = {}
+for name, values in samples.items():
+  result[name] = median(values)
+
+baseline = {}
+if baselinePath:
+  with open(baselinePath, 'r') as f:
+    baseline = json.load(f)
+
+regressions = []
+width = max(len(name) for name in result) if result else 0
+for name in sorted(result, key=lambda name: -result[name]):
+  line = name.ljust(width) + ' ' + ('%9.1f ms' % result[name])
+  if name in baseline:
+    was = baseline[name]
+    line += ' (baseline %9.1f ms)' % was
+    if result[name] > was * allowedSlowdown and result[name] - was > allowedSlowdownMs:
+      line += ' REGRESSION'
+      regressions.append(name)
+  print(line)
+
+if savePath:
+  with open(savePath, 'w') as f:
+    json.dump(result, f, indent=2, sort_keys=True)
+
+if regressions:
+  print('[ERROR] Slower than baseline: ' + ', '.join(regressions) + '.')
+  sys.exit(1)
@@ -10,11 +10,34 @@
 #include <functional>
 #include <QtCore/QDir>
 #include <QtCore/QSet>
+#include <QtCore/QCryptographicHash>
 #include <QtGui/QImage>
 #include <QtGui/QPainter>
 
 namespace codegen {
 namespace lang {
+namespace {
+
+// Identifies the keys layout, so that parsed values cached by one build
+// are not applied with different key indices in another one.
+QString ComputeKeysChecksum(const LangPack &langpack) {
+	QCryptographicHash hash(QCryptographicHash::Md5);
+	for (const auto &tag : langpack.tags) {
+		hash.addData(tag.tag.toUtf8() + '\n');
+	}
+	for (const auto &entry : langpack.entries) {
+		hash.addData(entry.key.toUtf8() + ':' + entry.keyBase.toUtf8());
+		for (const auto &tag : entry.tags) {
+			hash.addData(',' + tag.tag.toUtf8());
+		}
+		hash.addData("\n");
+	}
+	return "0x"
+		+ QString::fromLatin1(hash.result().left(8).toHex().toUpper())
+		+ "ULL";
+}
+
+} // namespace
 
 Generator::Generator(const LangPack &langpack, const QString &destBasePath, const common::ProjectInfo &project)
 : langpack_(langpack)
@@ -40,6 +63,7 @@ void Generator::writeHeaderForwardDeclarations() {
 \n\
 inline constexpr auto kTagsCount = ushort(" << langpack_.tags.size() << ");\n\
 inline constexpr auto kKeysCount = ushort(" << langpack_.entries.size() << ");\n\
+inline constexpr auto kKeysChecksum = quint64(" << ComputeKeysChecksum(langpack_) << ");\n\
 \n";
 	header_->popNamespace().newline();
 }
@@ -9,9 +9,15 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "base/debug_log.h"
 
+#include <atomic>
+#include <cmath>
 #include <mutex>
+#include <string>
+#include <execinfo.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <sys/mman.h>
 
 void SetMallocLogger(void (*logger)(size_t, void *));
 void SetVallocLogger(void (*logger)(size_t, void *));
@@ -30,16 +36,59 @@ namespace {
 
 constexpr auto kBufferSize = 1024 * 1024;
 
+// Sampled mode: each thread writes to its own buffer and only sampled
+// allocations are recorded, with their call stacks.
+constexpr auto kThreadBufferSize = 64 * 1024;
+constexpr auto kMaxThreadBuffers = 1024;
+constexpr auto kMaxStackDepth = 24;
+constexpr auto kSkipStackFrames = 3;
+constexpr auto kSampledSlotsShift = 20;
+constexpr auto kSampledSlots = std::size_t(1) << kSampledSlotsShift;
+constexpr auto kSampledMaxProbes = 64;
+constexpr auto kSampledTombstone = std::uint64_t(1);
+
+enum Command : char {
+    kMalloc = 1,
+    kRealloc = 2,
+    kFree = 3,
+    kSampledHeader = 4,
+    kSampledMalloc = 5,
+    kSampledFree = 6,
+    kSampledMaps = 7,
+};
+
 char *Buffer/* = nullptr*/;
 FILE *File/* = 0*/;
 char *Data/* = nullptr*/;
 std::mutex Mutex;
 
+struct ThreadBuffer {
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    std::atomic<bool> owned = false;
+    std::size_t used = 0;
+    char data[kThreadBufferSize];
+};
+
+struct ThreadState {
+    ThreadBuffer *buffer;
+    std::int64_t countdown;
+    std::uint64_t random;
+    bool busy;
+};
+
+std::size_t SampleBytes/* = 0*/;
+std::atomic<std::uint64_t> *Sampled/* = nullptr*/;
+std::atomic<ThreadBuffer*> ThreadBuffers[kMaxThreadBuffers];
+std::atomic<int> ThreadBuffersCount/* = 0*/;
+std::atomic<std::uint64_t> Sequence/* = 0*/;
+std::atomic<std::uint64_t> Dropped/* = 0*/;
+pthread_key_t ThreadKey;
+thread_local ThreadState Thread/* = {}*/;
+
 void WriteBlock() {
     if (Data > Buffer) {
         fwrite(Buffer, Data - Buffer, 1, File);
         fflush(File);
-        fdatasync(fileno(File));
         Data = Buffer;
     }
 }
@@ -59,7 +108,7 @@ void AppendEntry(char (&bytes)[Size]) {
 
 void MallocLogger(size_t size, void *result) {
     char entry[5 + sizeof(std::uint64_t) * 2];
-    entry[0] = 1;
+    entry[0] = kMalloc;
     *reinterpret_cast<std::uint64_t*>(entry + 5)
         = static_cast<std::uint64_t>(size);
     *reinterpret_cast<std::uint64_t*>(entry + 5 + sizeof(std::uint64_t))
@@ -84,7 +133,7 @@ void ReallocLogger(void *ptr, size_t size, void *result) {
         return MallocLogger(size, result);
     }
     char entry[5 + sizeof(std::uint64_t) * 3];
-    entry[0] = 2;
+    entry[0] = kRealloc;
     *reinterpret_cast<std::uint64_t*>(entry + 5)
         = reinterpret_cast<std::uint64_t>(ptr);
     *reinterpret_cast<std::uint64_t*>(entry + 5 + sizeof(std::uint64_t))
@@ -109,7 +158,7 @@ void PosixMemAlignLogger(size_t alignment, size_t size, void *result) {
 void FreeLogger(void *ptr) {
     if (ptr) {
         char entry[5 + sizeof(std::uint64_t)];
-        entry[0] = 3;
+        entry[0] = kFree;
         *reinterpret_cast<std::uint64_t*>(entry + 5)
             = reinterpret_cast<std::uint64_t>(ptr);
         AppendEntry(entry);
@@ -140,23 +189,316 @@ void RemoveLoggers() {
     SetFreeLogger(nullptr);
 }
 
+[[nodiscard]] void *AllocatePages(std::size_t size) {
+    const auto result = mmap(
+        nullptr,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    return (result != MAP_FAILED) ? result : nullptr;
+}
+
+// Live sampled addresses, an open addressing table with linear probing.
+[[nodiscard]] std::size_t SampledSlot(std::uint64_t address) {
+    return std::size_t(((address >> 4) * 0x9E3779B97F4A7C15ULL)
+        >> (64 - kSampledSlotsShift));
+}
+
+bool InsertSampled(std::uint64_t address) {
+    const auto index = SampledSlot(address);
+    for (auto i = 0; i != kSampledMaxProbes; ++i) {
+        auto &slot = Sampled[(index + i) & (kSampledSlots - 1)];
+        auto value = slot.load(std::memory_order_relaxed);
+        if ((value == 0 || value == kSampledTombstone)
+            && slot.compare_exchange_strong(value, address)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RemoveSampled(std::uint64_t address) {
+    const auto index = SampledSlot(address);
+    for (auto i = 0; i != kSampledMaxProbes; ++i) {
+        auto &slot = Sampled[(index + i) & (kSampledSlots - 1)];
+        auto value = slot.load(std::memory_order_relaxed);
+        if (value == address) {
+            // Keep probe chains short when nothing follows this slot.
+            const auto &next = Sampled[(index + i + 1) & (kSampledSlots - 1)];
+            const auto replace = next.load(std::memory_order_relaxed)
+                ? kSampledTombstone
+                : std::uint64_t(0);
+            return slot.compare_exchange_strong(value, replace);
+        } else if (value == 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+[[nodiscard]] std::int64_t NextSampleInterval() {
+    // xorshift64 and an exponential distribution with the sampling mean.
+    auto &x = Thread.random;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    const auto uniform = double((x >> 11) + 1) / double(1ULL << 53);
+    return std::int64_t(-std::log(uniform) * double(SampleBytes)) + 1;
+}
+
+void FlushThreadBuffer(not_null<ThreadBuffer*> buffer) {
+    std::unique_lock<std::mutex> lock(Mutex);
+    if (File && buffer->used) {
+        fwrite(buffer->data, buffer->used, 1, File);
+    }
+    buffer->used = 0;
+}
+
+[[nodiscard]] ThreadBuffer *AcquireThreadBuffer() {
+    const auto count = std::min(
+        ThreadBuffersCount.load(std::memory_order_acquire),
+        kMaxThreadBuffers);
+    for (auto i = 0; i != count; ++i) {
+        const auto buffer = ThreadBuffers[i].load(std::memory_order_acquire);
+        if (buffer && !buffer->owned.exchange(true)) {
+            return buffer;
+        }
+    }
+    const auto index = ThreadBuffersCount.fetch_add(1);
+    if (index >= kMaxThreadBuffers) {
+        return nullptr;
+    }
+    const auto memory = AllocatePages(sizeof(ThreadBuffer));
+    if (!memory) {
+        return nullptr;
+    }
+    const auto result = new (memory) ThreadBuffer();
+    result->owned = true;
+    ThreadBuffers[index].store(result, std::memory_order_release);
+    return result;
+}
+
+void ReleaseThreadBuffer(void *value) {
+    const auto buffer = static_cast<ThreadBuffer*>(value);
+    while (buffer->lock.test_and_set(std::memory_order_acquire)) {
+    }
+    FlushThreadBuffer(buffer);
+    buffer->lock.clear(std::memory_order_release);
+    buffer->owned = false;
+    Thread.buffer = nullptr;
+}
+
+void AppendThreadEntry(const char *entry, std::size_t size) {
+    auto buffer = Thread.buffer;
+    if (!buffer) {
+        buffer = Thread.buffer = AcquireThreadBuffer();
+        if (!buffer) {
+            Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pthread_setspecific(ThreadKey, buffer);
+    }
+    while (buffer->lock.test_and_set(std::memory_order_acquire)) {
+    }
+    if (buffer->used + size > kThreadBufferSize) {
+        FlushThreadBuffer(buffer);
+    }
+    memcpy(buffer->data + buffer->used, entry, size);
+    buffer->used += size;
+    buffer->lock.clear(std::memory_order_release);
+}
+
+__attribute__((noinline)) void RecordSampled(std::size_t size, void *result) {
+    const auto address = reinterpret_cast<std::uint64_t>(result);
+    if (!InsertSampled(address)) {
+        Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    void *frames[kMaxStackDepth + kSkipStackFrames];
+    const auto captured = backtrace(
+        frames,
+        kMaxStackDepth + kSkipStackFrames);
+    const auto skip = std::min(captured, kSkipStackFrames);
+    const auto depth = captured - skip;
+
+    constexpr auto kFixed = 5 + sizeof(std::uint64_t) * 3 + 1;
+    char entry[kFixed + sizeof(std::uint64_t) * kMaxStackDepth];
+    entry[0] = kSampledMalloc;
+    *reinterpret_cast<std::uint32_t*>(entry + 1) = uint32_t(time(nullptr));
+    *reinterpret_cast<std::uint64_t*>(entry + 5) = Sequence.fetch_add(1);
+    *reinterpret_cast<std::uint64_t*>(entry + 5 + sizeof(std::uint64_t))
+        = static_cast<std::uint64_t>(size);
+    *reinterpret_cast<std::uint64_t*>(entry + 5 + sizeof(std::uint64_t) * 2)
+        = address;
+    entry[kFixed - 1] = char(depth);
+    for (auto i = 0; i != depth; ++i) {
+        *reinterpret_cast<std::uint64_t*>(
+            entry + kFixed + sizeof(std::uint64_t) * i)
+            = reinterpret_cast<std::uint64_t>(frames[skip + i]);
+    }
+    AppendThreadEntry(entry, kFixed + sizeof(std::uint64_t) * depth);
+}
+
+void SampledMallocLogger(size_t size, void *result) {
+    if (!result || Thread.busy) {
+        return;
+    }
+    if (!Thread.random) {
+        // Draw the first interval as well, otherwise the first
+        // allocation of each thread would always be sampled.
+        Thread.random = reinterpret_cast<std::uint64_t>(&Thread)
+            ^ (std::uint64_t(time(nullptr)) << 32)
+            ^ 0x2545F4914F6CDD1DULL;
+        Thread.countdown = NextSampleInterval();
+    }
+    Thread.countdown -= std::int64_t(size);
+    if (Thread.countdown > 0) {
+        return;
+    }
+    Thread.busy = true;
+    Thread.countdown = NextSampleInterval();
+    RecordSampled(size, result);
+    Thread.busy = false;
+}
+
+void SampledFreeLogger(void *ptr) {
+    const auto address = reinterpret_cast<std::uint64_t>(ptr);
+    if (!address || !RemoveSampled(address)) {
+        return;
+    } else if (Thread.busy) {
+        // Freed while this thread holds its buffer lock.
+        Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Thread.busy = true;
+    char entry[5 + sizeof(std::uint64_t) * 2];
+    entry[0] = kSampledFree;
+    *reinterpret_cast<std::uint32_t*>(entry + 1) = uint32_t(time(nullptr));
+    *reinterpret_cast<std::uint64_t*>(entry + 5) = Sequence.fetch_add(1);
+    *reinterpret_cast<std::uint64_t*>(entry + 5 + sizeof(std::uint64_t))
+        = address;
+    AppendThreadEntry(entry, sizeof(entry));
+    Thread.busy = false;
+}
+
+void SampledVallocLogger(size_t size, void *result) {
+    SampledMallocLogger(size, result);
+}
+
+void SampledPVallocLogger(size_t size, void *result) {
+    SampledMallocLogger(size, result);
+}
+
+void SampledCallocLogger(size_t num, size_t size, void *result) {
+    SampledMallocLogger(num * size, result);
+}
+
+void SampledReallocLogger(void *ptr, size_t size, void *result) {
+    if (ptr) {
+        SampledFreeLogger(ptr);
+    }
+    SampledMallocLogger(size, result);
+}
+
+void SampledMemAlignLogger(size_t alignment, size_t size, void *result) {
+    SampledMallocLogger(size, result);
+}
+
+void SampledAlignedAllocLogger(
+        size_t alignment,
+        size_t size,
+        void *result) {
+    SampledMallocLogger(size, result);
+}
+
+void SampledPosixMemAlignLogger(
+        size_t alignment,
+        size_t size,
+        void *result) {
+    SampledMallocLogger(size, result);
+}
+
+void InstallSampledLoggers() {
+    SetMallocLogger(SampledMallocLogger);
+    SetVallocLogger(SampledVallocLogger);
+    SetPVallocLogger(SampledPVallocLogger);
+    SetCallocLogger(SampledCallocLogger);
+    SetReallocLogger(SampledReallocLogger);
+    SetMemAlignLogger(SampledMemAlignLogger);
+    SetAlignedAllocLogger(SampledAlignedAllocLogger);
+    SetPosixMemAlignLogger(SampledPosixMemAlignLogger);
+    SetFreeLogger(SampledFreeLogger);
+}
+
+void WriteSampledHeader() {
+    char header[5 + sizeof(std::uint64_t)];
+    header[0] = kSampledHeader;
+    *reinterpret_cast<std::uint32_t*>(header + 1) = uint32_t(time(nullptr));
+    *reinterpret_cast<std::uint64_t*>(header + 5) = SampleBytes;
+    fwrite(header, sizeof(header), 1, File);
+
+    // Module mappings let the reader resolve stack addresses offline.
+    auto maps = std::string();
+    if (const auto file = fopen("/proc/self/maps", "rb")) {
+        char chunk[4096];
+        while (const auto read = fread(chunk, 1, sizeof(chunk), file)) {
+            maps.append(chunk, read);
+        }
+        fclose(file);
+    }
+    char entry[5 + sizeof(std::uint32_t)];
+    entry[0] = kSampledMaps;
+    *reinterpret_cast<std::uint32_t*>(entry + 1) = uint32_t(time(nullptr));
+    *reinterpret_cast<std::uint32_t*>(entry + 5) = uint32_t(maps.size());
+    fwrite(entry, sizeof(entry), 1, File);
+    fwrite(maps.data(), maps.size(), 1, File);
+    fflush(File);
+}
+
+bool InitSampling(std::size_t sampleBytes) {
+    Sampled = static_cast<std::atomic<std::uint64_t>*>(AllocatePages(
+        sizeof(std::atomic<std::uint64_t>) * kSampledSlots));
+    if (!Sampled || pthread_key_create(&ThreadKey, ReleaseThreadBuffer)) {
+        return false;
+    }
+    SampleBytes = sampleBytes;
+
+    // The first backtrace() call loads libgcc_s and allocates.
+    void *frames[1];
+    backtrace(frames, 1);
+    return true;
+}
+
 #endif // DESKTOP_APP_USE_ALLOCATION_TRACER
 
 } // namespace
 
-void SetAllocationTracerPath(const QString &path) {
+void SetAllocationTracerPath(const QString &path, std::size_t sampleBytes) {
 #ifdef DESKTOP_APP_USE_ALLOCATION_TRACER
-    Expects(!Buffer);
+    Expects(!Buffer && !File);
 
-    Data = Buffer = new char[kBufferSize];
-    if (!Buffer) {
-        return;
+    if (sampleBytes) {
+        if (!InitSampling(sampleBytes)) {
+            return;
+        }
+    } else {
+        Data = Buffer = new char[kBufferSize];
+        if (!Buffer) {
+            return;
+        }
     }
     File = fopen(path.toStdString().c_str(), "wb");
     if (!File) {
         return;
     }
-    InstallLoggers();
+    if (sampleBytes) {
+        WriteSampledHeader();
+        InstallSampledLoggers();
+    } else {
+        InstallLoggers();
+    }
 #endif // DESKTOP_APP_USE_ALLOCATION_TRACER
 }
 
@@ -165,8 +507,29 @@ void FinishAllocationTracer() {
     if (File) {
         RemoveLoggers();
 
+        if (SampleBytes) {
+            const auto count = std::min(
+                ThreadBuffersCount.load(),
+                kMaxThreadBuffers);
+            for (auto i = 0; i != count; ++i) {
+                const auto buffer = ThreadBuffers[i].load();
+                if (!buffer) {
+                    continue;
+                }
+                while (buffer->lock.test_and_set(std::memory_order_acquire)) {
+                }
+                FlushThreadBuffer(buffer);
+                buffer->lock.clear(std::memory_order_release);
+            }
+            if (const auto dropped = Dropped.load()) {
+                LOG(("Allocation Tracer: %1 samples dropped.").arg(dropped));
+            }
+        }
+
         std::unique_lock<std::mutex> lock(Mutex);
-        WriteBlock();
+        if (!SampleBytes) {
+            WriteBlock();
+        }
         fclose(File);
         File = nullptr;
     }
@@ -9,7 +9,9 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace base::Platform {
 
-void SetAllocationTracerPath(const QString &path);
+// With non-zero sampleBytes about one allocation per sampleBytes of
+// allocated memory is recorded, together with its call stack.
+void SetAllocationTracerPath(const QString &path, std::size_t sampleBytes = 0);
 void FinishAllocationTracer();
 
 } // namespace base::Platform
@@ -15,13 +15,21 @@ namespace crl {
 
 queue::queue() = default;
 
+queue::queue(priority value) : _priority(value) {
+}
+
 queue::queue(main_queue_processor processor) : _main_processor(processor) {
 }
 
 void queue::wake_async() {
 	auto expected = false;
-	if (_queued.compare_exchange_strong(expected, true)) {
-		(_main_processor ? _main_processor : details::async_plain)(
+	if (!_queued.compare_exchange_strong(expected, true)) {
+		return;
+	} else if (_main_processor) {
+		_main_processor(ProcessCallback, static_cast<void*>(this));
+	} else {
+		details::async_plain(
+			_priority,
 			ProcessCallback,
 			static_cast<void*>(this));
 	}
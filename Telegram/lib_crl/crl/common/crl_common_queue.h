@@ -22,6 +22,7 @@ class main_queue_pointer;
 class queue {
 public:
 	queue();
+	explicit queue(priority value);
 	queue(const queue &other) = delete;
 	queue &operator=(const queue &other) = delete;
 
@@ -53,6 +54,7 @@ private:
 	void process();
 
 	main_queue_processor _main_processor = nullptr;
+	priority _priority = priority::normal;
 	details::list _list;
 	std::atomic<bool> _queued = false;
 
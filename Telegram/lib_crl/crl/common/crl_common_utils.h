@@ -14,6 +14,14 @@ namespace crl {
 using main_queue_processor = void(*)(void (*callable)(void*), void *argument);
 using main_queue_wrapper = void(*)(void (*callable)(void*), void *argument);
 
+// Only crl::async() and crl::queue take a priority, crl::on_main()
+// work always runs in order on the main thread. Backends that can't
+// prioritize work treat every value as normal.
+enum class priority {
+	normal,
+	background,
+};
+
 } // namespace crl
 
 namespace crl::details {
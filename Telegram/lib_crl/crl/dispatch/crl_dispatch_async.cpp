@@ -22,6 +22,17 @@ void *background_queue_dispatch() {
 	return dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
 }
 
+void *priority_queue_dispatch(priority value) {
+	const auto identifier = [&] {
+		switch (value) {
+		case priority::normal: return DISPATCH_QUEUE_PRIORITY_DEFAULT;
+		case priority::background: return DISPATCH_QUEUE_PRIORITY_BACKGROUND;
+		}
+		return DISPATCH_QUEUE_PRIORITY_DEFAULT;
+	}();
+	return dispatch_get_global_queue(identifier, 0);
+}
+
 void *main_queue_dispatch() {
 	return dispatch_get_main_queue();
 }
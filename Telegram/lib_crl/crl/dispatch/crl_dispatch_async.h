@@ -16,6 +16,7 @@
 namespace crl::details {
 
 void *background_queue_dispatch();
+void *priority_queue_dispatch(priority value);
 void *main_queue_dispatch();
 
 void on_queue_async(void *queue, void (*callable)(void*), void *argument);
@@ -68,6 +69,16 @@ inline void async_plain(void (*callable)(void*), void *argument) {
 		argument);
 }
 
+inline void async_plain(
+		priority value,
+		void (*callable)(void*),
+		void *argument) {
+	return on_queue_async(
+		priority_queue_dispatch(value),
+		callable,
+		argument);
+}
+
 } // namespace crl::details
 
 namespace crl {
@@ -80,6 +91,14 @@ inline void async(Callable &&callable) {
 		std::forward<Callable>(callable));
 }
 
+template <typename Callable>
+inline void async(priority value, Callable &&callable) {
+	return details::on_queue_invoke<details::EmptyWrapper>(
+		details::priority_queue_dispatch(value),
+		details::on_queue_async,
+		std::forward<Callable>(callable));
+}
+
 template <typename Callable>
 inline void sync(Callable &&callable) {
 	return details::on_queue_invoke<details::EmptyWrapper>(
@@ -8,6 +8,8 @@
 
 #if defined CRL_USE_DISPATCH && !defined CRL_USE_COMMON_QUEUE
 
+#include <crl/dispatch/crl_dispatch_async.h>
+
 #include <dispatch/dispatch.h>
 #include <exception>
 
@@ -20,11 +22,16 @@ dispatch_queue_t Unwrap(void *value) {
 
 } // namespace
 
-auto queue::implementation::create() -> pointer {
+auto queue::implementation::create(priority value) -> pointer {
 	auto result = dispatch_queue_create(nullptr, DISPATCH_QUEUE_SERIAL);
 	if (!result) {
 		std::terminate();
 	}
+	if (value != priority::normal) {
+		dispatch_set_target_queue(
+			result,
+			Unwrap(details::priority_queue_dispatch(value)));
+	}
 	return result;
 }
 
@@ -34,7 +41,10 @@ void queue::implementation::operator()(pointer value) {
 	}
 };
 
-queue::queue() : _handle(implementation::create()) {
+queue::queue() : queue(priority::normal) {
+}
+
+queue::queue(priority value) : _handle(implementation::create(value)) {
 }
 
 void queue::async_plain(void (*callable)(void*), void *argument) {
@@ -19,6 +19,7 @@ namespace crl {
 class queue {
 public:
 	queue();
+	explicit queue(priority value);
 
 	template <
 		typename Callable,
@@ -70,7 +71,7 @@ private:
 	// Hide dispatch_queue_t
 	struct implementation {
 		using pointer = void*;
-		static pointer create();
+		static pointer create(priority value);
 		void operator()(pointer value);
 	};
 
@@ -43,10 +43,20 @@ inline auto create_runnable(Callable &&callable) {
 	}
 }
 
+[[nodiscard]] inline int pool_priority(priority value) {
+	switch (value) {
+	case priority::normal: return 0;
+	case priority::background: return -1;
+	}
+	return 0;
+}
+
 template <typename Callable>
-inline void async_any(Callable &&callable) {
+inline void async_any(Callable &&callable, priority value = priority::normal) {
 	if (const auto pool = QThreadPool::globalInstance()) {
-		pool->start(create_runnable(std::forward<Callable>(callable)));
+		pool->start(
+			create_runnable(std::forward<Callable>(callable)),
+			pool_priority(value));
 	}
 }
 
@@ -56,6 +66,15 @@ inline void async_plain(void (*callable)(void*), void *argument) {
 	});
 }
 
+inline void async_plain(
+		priority value,
+		void (*callable)(void*),
+		void *argument) {
+	async_any([=] {
+		callable(argument);
+	}, value);
+}
+
 } // namespace crl::details
 
 namespace crl {
@@ -67,6 +86,13 @@ inline void async(Callable &&callable) {
 	details::async_any(std::forward<Callable>(callable));
 }
 
+template <
+	typename Callable,
+	typename Return = decltype(std::declval<Callable>()())>
+inline void async(priority value, Callable &&callable) {
+	details::async_any(std::forward<Callable>(callable), value);
+}
+
 } // namespace crl
 
 #endif // CRL_USE_QT
@@ -18,6 +18,14 @@ namespace crl::details {
 
 void async_plain(void (*callable)(void*), void *argument);
 
+// The concurrency runtime scheduler has no per-task priorities.
+inline void async_plain(
+		priority,
+		void (*callable)(void*),
+		void *argument) {
+	async_plain(callable, argument);
+}
+
 } // namespace crl::details
 
 namespace crl {
@@ -45,6 +53,13 @@ inline void async(Callable &&callable) {
 	}
 }
 
+template <
+	typename Callable,
+	typename Return = decltype(std::declval<Callable>()())>
+inline void async(priority, Callable &&callable) {
+	async(std::forward<Callable>(callable));
+}
+
 } // namespace crl
 
 #endif // CRL_USE_WINAPI
@@ -0,0 +1,115 @@
+// This file is part of Desktop App Toolkit,
+// a set of libraries for developing nice desktop applications.
+//
+// For license and copyright information please follow this link:
+// https://github.com/desktop-app/legal/blob/master/LEGAL
+//
+#include <catch.hpp>
+
+#include <rpl/rpl.h>
+#include <chrono>
+#include <string>
+
+using namespace rpl;
+
+// Hidden from the default run, start with the "[benchmark]" tag.
+
+namespace {
+
+constexpr auto kIterations = 100'000;
+
+template <typename Callback>
+void Measure(const std::string &name, Callback &&callback) {
+	const auto start = std::chrono::steady_clock::now();
+	for (auto i = 0; i != kIterations; ++i) {
+		callback(i);
+	}
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		elapsed).count();
+	WARN(name << ": " << (ns / kIterations) << " ns per iteration");
+}
+
+} // namespace
+
+TEST_CASE("rpl subscription benchmarks", "[.][benchmark]") {
+	auto sum = 0;
+
+	SECTION("erased producer subscribe") {
+		const auto value = producer<int>([](auto &&consumer) {
+			consumer.put_next(1);
+			return lifetime();
+		});
+		Measure("erased producer subscribe", [&](int) {
+			auto alive = lifetime();
+			duplicate(value) | start_with_next([&](int value) {
+				sum += value;
+			}, alive);
+		});
+		REQUIRE(sum == kIterations);
+	}
+
+	SECTION("map and filter chain subscribe") {
+		const auto value = single(1);
+		Measure("map and filter chain subscribe", [&](int) {
+			auto alive = lifetime();
+			duplicate(value) | map([](int value) {
+				return value * 2;
+			}) | filter([](int value) {
+				return value > 0;
+			}) | start_with_next([&](int value) {
+				sum += value;
+			}, alive);
+		});
+		REQUIRE(sum == 2 * kIterations);
+	}
+
+	SECTION("combine subscribe") {
+		Measure("combine subscribe", [&](int) {
+			auto alive = lifetime();
+			combine(
+				single(1),
+				single(2)
+			) | start_with_next([&](int a, int b) {
+				sum += a + b;
+			}, alive);
+		});
+		REQUIRE(sum == 3 * kIterations);
+	}
+
+	SECTION("event_stream subscribe") {
+		auto stream = event_stream<int>();
+		Measure("event_stream subscribe", [&](int) {
+			auto alive = lifetime();
+			stream.events() | start_with_next([&](int value) {
+				sum += value;
+			}, alive);
+		});
+		REQUIRE(sum == 0);
+	}
+
+	SECTION("event_stream fire") {
+		auto stream = event_stream<int>();
+		auto alive = lifetime();
+		for (auto i = 0; i != 16; ++i) {
+			stream.events() | start_with_next([&](int value) {
+				sum += value;
+			}, alive);
+		}
+		Measure("event_stream fire to 16 subscribers", [&](int) {
+			stream.fire(1);
+		});
+		REQUIRE(sum == 16 * kIterations);
+	}
+
+	SECTION("variable value subscribe") {
+		auto var = variable<int>(1);
+		Measure("variable value subscribe", [&](int) {
+			auto alive = lifetime();
+			var.value() | start_with_next([&](int value) {
+				sum += value;
+			}, alive);
+		});
+		REQUIRE(sum == kIterations);
+	}
+}
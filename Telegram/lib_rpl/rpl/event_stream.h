@@ -56,13 +56,25 @@ public:
 			if (const auto strong = weak.lock()) {
 				auto result = [weak, consumer] {
 					if (const auto strong = weak.lock()) {
+						// Usually the latest subscriptions end first.
+						auto &consumers = strong->consumers;
 						const auto it = std::find(
-							strong->consumers.begin(),
-							strong->consumers.end(),
+							consumers.rbegin(),
+							consumers.rend(),
 							consumer);
-						if (it != strong->consumers.end()) {
+						if (it == consumers.rend()) {
+							return;
+						} else if (strong->depth) {
 							it->terminate();
+							return;
 						}
+
+						// Don't let streams that are rarely fired
+						// accumulate ended consumers. Erase it first,
+						// terminate() may subscribe to this stream.
+						auto ended = std::move(*it);
+						consumers.erase(std::next(it).base());
+						ended.terminate();
 					}
 				};
 				strong->consumers.push_back(std::move(consumer));
@@ -175,6 +187,7 @@ inline void event_stream<Value, Error>::fire_error_forward(
 	if (consumers.empty()) {
 		return;
 	}
+	++data->depth;
 	const auto begin = base::index_based_begin(consumers);
 	const auto end = base::index_based_end(consumers);
 
@@ -193,6 +206,8 @@ inline void event_stream<Value, Error>::fire_error_forward(
 template <typename Value, typename Error>
 void event_stream<Value, Error>::fire_done() const {
 	if (const auto data = details::take(_data)) {
+		// Ended consumers should not be erased while we iterate.
+		++data->depth;
 		for (const auto &consumer : data->consumers) {
 			consumer.put_done();
 		}
@@ -74,6 +74,10 @@ inline void lifetime::add(Destroy &&destroy) {
 }
 
 inline void lifetime::add(lifetime &&other) {
+	if (_callbacks.empty()) {
+		_callbacks = details::take(other._callbacks);
+		return;
+	}
 	auto callbacks = details::take(other._callbacks);
 	_callbacks.insert(
 		_callbacks.end(),
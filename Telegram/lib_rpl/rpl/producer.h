@@ -7,6 +7,7 @@
 #pragma once
 
 #include <functional>
+#include <new>
 #include <rpl/consumer.h>
 #include <rpl/lifetime.h>
 #include <rpl/details/superset_type.h>
@@ -22,31 +23,10 @@ namespace details {
 template <typename Value, typename Error>
 const consumer<Value, Error> &const_ref_consumer();
 
-template <typename Lambda>
-class mutable_lambda_wrap {
-public:
-	mutable_lambda_wrap(Lambda &&lambda)
-		: _lambda(std::move(lambda)) {
-	}
-	mutable_lambda_wrap(const mutable_lambda_wrap &other) = default;
-	mutable_lambda_wrap(mutable_lambda_wrap &&other) = default;
-	mutable_lambda_wrap &operator=(
-		const mutable_lambda_wrap &other) = default;
-	mutable_lambda_wrap &operator=(
-		mutable_lambda_wrap &&other) = default;
-
-	template <typename... Args>
-	auto operator()(Args&&... args) const {
-		return (const_cast<mutable_lambda_wrap*>(this)->_lambda)(
-			std::forward<Args>(args)...);
-	}
-
-private:
-	Lambda _lambda;
-
-};
-
-// Type-erased copyable mutable function using std::function.
+// Type-erased copyable mutable function.
+//
+// Small generators are stored inline, so erasing most producers
+// doesn't allocate. Larger ones are kept on the heap.
 template <typename Value, typename Error>
 class type_erased_generator final {
 public:
@@ -55,19 +35,44 @@ public:
 	using value_type = Value;
 	using error_type = Error;
 
-	type_erased_generator(
-		const type_erased_generator &other) = default;
-	type_erased_generator(
-		type_erased_generator &&other) = default;
-	type_erased_generator &operator=(
-		const type_erased_generator &other) = default;
+	type_erased_generator(const type_erased_generator &other) {
+		if (other._methods) {
+			other._methods->copy(other._storage, _storage);
+			_methods = other._methods;
+		}
+	}
+	type_erased_generator(type_erased_generator &&other) noexcept {
+		if (other._methods) {
+			other._methods->move(other._storage, _storage);
+			_methods = std::exchange(other._methods, nullptr);
+		}
+	}
+	type_erased_generator &operator=(const type_erased_generator &other) {
+		if (this != &other) {
+			auto copy = other;
+			*this = std::move(copy);
+		}
+		return *this;
+	}
 	type_erased_generator &operator=(
-		type_erased_generator &&other) = default;
+			type_erased_generator &&other) noexcept {
+		if (this != &other) {
+			reset();
+			if (other._methods) {
+				other._methods->move(other._storage, _storage);
+				_methods = std::exchange(other._methods, nullptr);
+			}
+		}
+		return *this;
+	}
+	~type_erased_generator() {
+		reset();
+	}
 
 	type_erased_generator(std::nullptr_t = nullptr) {
 	}
 	type_erased_generator &operator=(std::nullptr_t) {
-		_implementation = nullptr;
+		reset();
 		return *this;
 	}
 
@@ -81,8 +86,8 @@ public:
 			!std::is_same_v<
 				std::decay_t<Generator>,
 				type_erased_generator>>>
-	type_erased_generator(Generator other) : _implementation(
-		mutable_lambda_wrap<Generator>(std::move(other))) {
+	type_erased_generator(Generator other) {
+		emplace(std::move(other));
 	}
 	template <
 		typename Generator,
@@ -95,22 +100,105 @@ public:
 				std::decay_t<Generator>,
 				type_erased_generator>>>
 	type_erased_generator &operator=(Generator other) {
-		_implementation = mutable_lambda_wrap<Generator>(
-			std::move(other));
+		reset();
+		emplace(std::move(other));
 		return *this;
 	}
 
 	template <typename Handlers>
 	lifetime operator()(const consumer_type<Handlers> &consumer) {
-		return _implementation ? _implementation(consumer) : lifetime();
+		return _methods ? _methods->call(_storage, consumer) : lifetime();
 	}
 
 	bool empty() const {
-		return !_implementation;
+		return !_methods;
 	}
 
 private:
-	std::function<lifetime(const consumer_type<type_erased_handlers<Value, Error>> &)> _implementation;
+	using erased_consumer = consumer_type<type_erased_handlers<Value, Error>>;
+
+	struct methods {
+		lifetime (*call)(void *storage, const erased_consumer &consumer);
+		void (*copy)(const void *from, void *to);
+		void (*move)(void *from, void *to);
+		void (*destroy)(void *storage);
+	};
+
+	static constexpr auto kInlineSize = 4 * sizeof(void*);
+
+	template <typename Generator>
+	static constexpr bool is_inline_v = (sizeof(Generator) <= kInlineSize)
+		&& (alignof(Generator) <= alignof(void*))
+		&& std::is_nothrow_move_constructible_v<Generator>;
+
+	template <typename Generator>
+	static Generator *inline_value(void *storage) {
+		return std::launder(static_cast<Generator*>(storage));
+	}
+	template <typename Generator>
+	static const Generator *inline_value(const void *storage) {
+		return std::launder(static_cast<const Generator*>(storage));
+	}
+	template <typename Generator>
+	static Generator *heap_value(const void *storage) {
+		return *std::launder(static_cast<Generator* const*>(storage));
+	}
+
+	template <typename Generator>
+	static constexpr methods inline_methods = {
+		[](void *storage, const erased_consumer &consumer) -> lifetime {
+			return (*inline_value<Generator>(storage))(consumer);
+		},
+		[](const void *from, void *to) {
+			new (to) Generator(*inline_value<Generator>(from));
+		},
+		[](void *from, void *to) {
+			const auto value = inline_value<Generator>(from);
+			new (to) Generator(std::move(*value));
+			value->~Generator();
+		},
+		[](void *storage) {
+			inline_value<Generator>(storage)->~Generator();
+		},
+	};
+
+	template <typename Generator>
+	static constexpr methods heap_methods = {
+		[](void *storage, const erased_consumer &consumer) -> lifetime {
+			return (*heap_value<Generator>(storage))(consumer);
+		},
+		[](const void *from, void *to) {
+			new (to) Generator*(new Generator(*heap_value<Generator>(from)));
+		},
+		[](void *from, void *to) {
+			new (to) Generator*(heap_value<Generator>(from));
+		},
+		[](void *storage) {
+			delete heap_value<Generator>(storage);
+		},
+	};
+
+	template <typename Generator>
+	void emplace(Generator &&generator) {
+		using Stored = std::decay_t<Generator>;
+		if constexpr (is_inline_v<Stored>) {
+			new (_storage) Stored(std::forward<Generator>(generator));
+			_methods = &inline_methods<Stored>;
+		} else {
+			new (_storage) Stored*(
+				new Stored(std::forward<Generator>(generator)));
+			_methods = &heap_methods<Stored>;
+		}
+	}
+
+	void reset() {
+		if (const auto methods = std::exchange(_methods, nullptr)) {
+			methods->destroy(_storage);
+		}
+	}
+
+	alignas(void*) unsigned char _storage[kInlineSize];
+	const methods *_methods = nullptr;
 
 };
 
@@ -8,6 +8,7 @@
 
 #include <rpl/producer.h>
 #include <rpl/event_stream.h>
+#include <array>
 
 using namespace rpl;
 
@@ -159,6 +160,46 @@ TEST_CASE("basic producer tests", "[rpl::producer]") {
 		}
 		REQUIRE(*result == 3);
 	}
+
+	SECTION("type erased producer copy and move test") {
+		auto sum = std::make_shared<int>(0);
+		auto destroyed = std::make_shared<int>(0);
+		{
+			auto destroyCaller = std::make_shared<OnDestructor>([=] {
+				++*destroyed;
+			});
+			const auto small = producer<int>([=](auto &&consumer) {
+				(void)destroyCaller;
+				consumer.put_next(1);
+				return lifetime();
+			});
+			auto padding = std::array<int, 64>();
+			padding.fill(10);
+			const auto large = producer<int>([=](auto &&consumer) {
+				(void)destroyCaller;
+				consumer.put_next_copy(padding[0]);
+				return lifetime();
+			});
+			auto alive = lifetime();
+			for (const auto &original : { small, large }) {
+				auto copy = original;
+				auto moved = std::move(copy);
+				REQUIRE(!copy);
+				moved.start_copy([=](int value) {
+					*sum += value;
+				}, [=](no_error) {
+				}, [=] {
+				}, alive);
+				std::move(moved).start([=](int value) {
+					*sum += value;
+				}, [=](no_error) {
+				}, [=] {
+				}, alive);
+			}
+		}
+		REQUIRE(*sum == 1 + 1 + 10 + 10);
+		REQUIRE(*destroyed == 1);
+	}
 }
 
 TEST_CASE("basic event_streams tests", "[rpl::event_stream]") {
@@ -237,6 +278,35 @@ TEST_CASE("basic event_streams tests", "[rpl::event_stream]") {
 			(13 + 13 + 13 + 13 + 13 + 13));
 	}
 
+	SECTION("event_stream subscribe while unsubscribing test") {
+		auto sum = std::make_shared<int>(0);
+		event_stream<int> stream;
+		auto added = lifetime();
+		auto subscription = lifetime();
+		auto saved = lifetime();
+		make_producer<int>([&](const auto &consumer) {
+			subscription = stream.events().start_existing(consumer);
+			return lifetime([&] {
+				// Enough to reallocate the consumers of the stream.
+				for (auto i = 0; i != 16; ++i) {
+					stream.events().start([=](int value) {
+						*sum += value;
+					}, [=](no_error) {
+					}, [=] {
+					}, added);
+				}
+			});
+		}).start([](int) {
+		}, [](no_error) {
+		}, [] {
+		}, saved);
+
+		subscription.destroy();
+		stream.fire(1);
+
+		REQUIRE(*sum == 16);
+	}
+
 	SECTION("event_stream add and remove in handler test") {
 		auto sum = std::make_shared<int>(0);
 		event_stream<int> stream;
@@ -23,7 +23,7 @@ void ClearLegacyFilesPart(
 		=,
 		files = details::CollectFiles(base, kClearPartSize, skip)
 	](base::flat_set<QString> &&skip) mutable {
-		crl::async([
+		crl::async(crl::priority::background, [
 			=,
 			files = std::move(files),
 			skip = std::move(skip)
@@ -44,7 +44,7 @@ void ClearLegacyFilesPart(
 void ClearLegacyFiles(const QString &base, CollectGoodFiles filter) {
 	Expects(base.endsWith('/'));
 
-	crl::async([=] {
+	crl::async(crl::priority::background, [=] {
 		ClearLegacyFilesPart(base, std::move(filter));
 	});
 }
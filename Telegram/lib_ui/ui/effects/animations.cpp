@@ -8,8 +8,13 @@
 
 #include "ui/ui_utility.h"
 #include "base/invoke_queued.h"
+#include "base/debug_log.h"
 
 #include <QtCore/QPointer>
+#include <QtCore/QEvent>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QScreen>
+#include <QtGui/QWindow>
 
 #include <crl/crl_on_main.h>
 #include <crl/crl.h>
@@ -18,15 +23,47 @@
 #include <range/v3/algorithm/remove.hpp>
 #include <range/v3/algorithm/find.hpp>
 
+#include <cmath>
+
 namespace Ui {
 namespace Animations {
 namespace {
 
-constexpr auto kAnimationTick = crl::time(1000) / 120;
+// Ticks follow the fastest screen refresh rate, 120 Hz if it is unknown.
+constexpr auto kDefaultRefreshRate = 120.;
+constexpr auto kMinRefreshRate = 30.;
+constexpr auto kMaxRefreshRate = 240.;
 constexpr auto kIgnoreUpdatesTimeout = crl::time(4);
 
+// Animations still finish while no window is visible, just rarely ticked.
+constexpr auto kHiddenAnimationTick = crl::time(100);
+
+constexpr auto kStatsInterval = 30 * crl::time(1000);
+constexpr auto kStatsBucketsMs = std::array<crl::time, 5>{ 1, 2, 4, 8, 16 };
+
 Manager *ManagerInstance = nullptr;
 
+[[nodiscard]] crl::time ComputeAnimationTick() {
+	auto rate = 0.;
+	for (const auto screen : QGuiApplication::screens()) {
+		rate = std::max(rate, screen->refreshRate());
+	}
+	if (rate <= 0.) {
+		rate = kDefaultRefreshRate;
+	}
+	rate = std::clamp(rate, kMinRefreshRate, kMaxRefreshRate);
+	return std::max(crl::time(1), crl::time(std::round(1000. / rate)));
+}
+
+[[nodiscard]] bool AnyWindowExposed() {
+	for (const auto window : QGuiApplication::topLevelWindows()) {
+		if (window->isExposed()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 } // namespace
 
 void Basic::start() {
@@ -74,6 +111,22 @@ Manager::Manager() {
 
 	ManagerInstance = this;
 
+	refreshTick();
+	for (const auto screen : QGuiApplication::screens()) {
+		watchScreen(screen);
+	}
+	QObject::connect(qApp, &QGuiApplication::screenAdded, this, [=](
+			QScreen *screen) {
+		watchScreen(screen);
+		refreshTick();
+	});
+	QObject::connect(qApp, &QGuiApplication::screenRemoved, this, [=] {
+		refreshTick();
+	});
+
+	// Exposed windows are counted again only after they could change.
+	QCoreApplication::instance()->installEventFilter(this);
+
 	crl::on_main_update_requests(
 	) | rpl::filter([=] {
 		return (_lastUpdateTime + kIgnoreUpdatesTimeout < crl::now());
@@ -133,11 +186,13 @@ void Manager::update() {
 	_updating = true;
 	const auto guard = gsl::finally([&] { _updating = false; });
 
-	_lastUpdateTime = now;
+	const auto previous = std::exchange(_lastUpdateTime, now);
 	const auto isFinished = [&](const ActiveBasicPointer &element) {
 		return !element.call(now);
 	};
+	const auto started = crl::profile();
 	_active.erase(ranges::remove_if(_active, isFinished), end(_active));
+	accumulateStats(now, previous, crl::profile() - started);
 
 	if (_removedWhileUpdating) {
 		_removedWhileUpdating = false;
@@ -182,7 +237,7 @@ void Manager::schedule() {
 			_forceImmediateUpdate = false;
 			updateQueued();
 		} else {
-			const auto next = _lastUpdateTime + kAnimationTick;
+			const auto next = _lastUpdateTime + nextTickDelay();
 			const auto now = crl::now();
 			if (now < next) {
 				_timerId = startTimer(next - now, Qt::PreciseTimer);
@@ -207,5 +262,71 @@ void Manager::timerEvent(QTimerEvent *e) {
 	update();
 }
 
+void Manager::watchScreen(not_null<QScreen*> screen) {
+	QObject::connect(screen, &QScreen::refreshRateChanged, this, [=] {
+		refreshTick();
+	});
+}
+
+void Manager::refreshTick() {
+	_tick = ComputeAnimationTick();
+}
+
+bool Manager::eventFilter(QObject *object, QEvent *e) {
+	const auto type = e->type();
+	if ((type == QEvent::Expose
+		|| type == QEvent::Show
+		|| type == QEvent::Hide
+		|| type == QEvent::WindowStateChange
+		|| type == QEvent::PlatformSurface)
+		&& object->isWindowType()) {
+		_anyWindowExposed = std::nullopt;
+	}
+	return QObject::eventFilter(object, e);
+}
+
+crl::time Manager::nextTickDelay() const {
+	if (!_anyWindowExposed) {
+		_anyWindowExposed = AnyWindowExposed();
+	}
+	return *_anyWindowExposed ? _tick : kHiddenAnimationTick;
+}
+
+void Manager::accumulateStats(
+		crl::time now,
+		crl::time previous,
+		crl::profile_time duration) {
+	if (!_stats.started) {
+		_stats.started = now;
+	}
+	const auto ms = duration / 1000;
+	const auto bucket = std::find_if(
+		begin(kStatsBucketsMs),
+		end(kStatsBucketsMs),
+		[&](crl::time limit) { return ms < limit; });
+	++_stats.durations[bucket - begin(kStatsBucketsMs)];
+	++_stats.ticks;
+	const auto interval = previous ? (now - previous) : 0;
+	if (interval * 2 > _tick * 3 && interval < kHiddenAnimationTick) {
+		++_stats.late;
+	}
+	if (now - _stats.started < kStatsInterval) {
+		return;
+	}
+	const auto &d = _stats.durations;
+	DEBUG_LOG(("Animations: %1 ticks of %2 ms, %3 late, durations "
+		"<1ms: %4, <2ms: %5, <4ms: %6, <8ms: %7, <16ms: %8, more: %9."
+		).arg(_stats.ticks
+		).arg(_tick
+		).arg(_stats.late
+		).arg(d[0]
+		).arg(d[1]
+		).arg(d[2]
+		).arg(d[3]
+		).arg(d[4]
+		).arg(d[5]));
+	_stats = FrameStats();
+}
+
 } // namespace Animations
 } // namespace Ui
@@ -11,6 +11,11 @@
 #include <crl/crl_time.h>
 #include <rpl/lifetime.h>
 
+#include <array>
+#include <optional>
+
+class QScreen;
+
 namespace Ui {
 namespace Animations {
 
@@ -183,9 +188,17 @@ private:
 
 	};
 
+	struct FrameStats {
+		std::array<int, 6> durations = { { 0 } };
+		int ticks = 0;
+		int late = 0;
+		crl::time started = 0;
+	};
+
 	friend class Basic;
 
 	void timerEvent(QTimerEvent *e) override;
+	bool eventFilter(QObject *object, QEvent *e) override;
 
 	void start(not_null<Basic*> animation);
 	void stop(not_null<Basic*> animation);
@@ -195,6 +208,17 @@ private:
 	void stopTimer();
 	not_null<const QObject*> delayedCallGuard() const;
 
+	void watchScreen(not_null<QScreen*> screen);
+	void refreshTick();
+	[[nodiscard]] crl::time nextTickDelay() const;
+	void accumulateStats(
+		crl::time now,
+		crl::time previous,
+		crl::profile_time duration);
+
+	crl::time _tick = 0;
+	mutable std::optional<bool> _anyWindowExposed;
+	FrameStats _stats;
 	crl::time _lastUpdateTime = 0;
 	int _timerId = 0;
 	bool _updating = false;
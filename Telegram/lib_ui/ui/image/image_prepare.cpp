@@ -435,6 +435,15 @@ std::array<QImage, 4> PrepareCorners(
 	if (size.width() * size.height() > kReadMaxArea) {
 		return {};
 	}
+	if (!args.maxSize.isEmpty()) {
+		// Let the decoder downscale, JPEG skips most of the work this way.
+		const auto rotated = (reader.transformation()
+			& QImageIOHandler::TransformationRotate90);
+		const auto max = rotated ? args.maxSize.transposed() : args.maxSize;
+		if (size.width() > max.width() || size.height() > max.height()) {
+			reader.setScaledSize(size.scaled(max, Qt::KeepAspectRatio));
+		}
+	}
 	auto result = ReadResult();
 	result.format = reader.format().toLower();
 	result.animated = reader.supportsAnimation()
@@ -1056,8 +1065,13 @@ QImage Round(
 		Assert(imageIntsAdded >= 0);
 		for (auto y = 0; y != maskHeight; ++y) {
 			for (auto x = 0; x != maskWidth; ++x) {
-				auto opacity = static_cast<anim::ShiftedMultiplier>(*maskBytes) + 1;
-				*imageInts = anim::unshifted(anim::shifted(*imageInts) * opacity);
+				const auto mask = *maskBytes;
+				if (!mask) {
+					*imageInts = 0;
+				} else if (mask != 0xFF) {
+					auto opacity = static_cast<anim::ShiftedMultiplier>(mask) + 1;
+					*imageInts = anim::unshifted(anim::shifted(*imageInts) * opacity);
+				}
 				maskBytes += maskBytesPerPixel;
 				imageInts += imageIntsPerPixel;
 			}
@@ -1123,28 +1137,29 @@ QImage Colored(QImage &&image, QColor add) {
 			QImage::Format_ARGB32_Premultiplied);
 	}
 
-	if (const auto pix = image.bits()) {
-		const auto ca = int(add.alphaF() * 0xFF);
-		const auto cr = int(add.redF() * 0xFF);
-		const auto cg = int(add.greenF() * 0xFF);
-		const auto cb = int(add.blueF() * 0xFF);
+	if (const auto ints = reinterpret_cast<uint32*>(image.bits())) {
+		const auto ca = uint32(add.alphaF() * 0xFF);
+		const auto target = anim::shifted(0xFF000000U
+			| (uint32(add.redF() * 0xFF) << 16)
+			| (uint32(add.greenF() * 0xFF) << 8)
+			| uint32(add.blueF() * 0xFF));
 		const auto w = image.width();
 		const auto h = image.height();
-		const auto add = image.bytesPerLine() - (w * 4);
-		auto i = index_type();
+		const auto addPerLine = (image.bytesPerLine() / sizeof(uint32)) - w;
+
+		// Blend all four components in one multiplication, the blend
+		// ratio is (pixel alpha) * (color alpha) in the 0..255 range.
+		auto i = ints;
 		for (auto y = 0; y != h; ++y) {
-			for (auto to = i + (w * 4); i != to; i += 4) {
-				const auto b = pix[i];
-				const auto g = pix[i + 1];
-				const auto r = pix[i + 2];
-				const auto a = pix[i + 3];
-				const auto aca = a * ca;
-				pix[i + 0] = uchar(b + ((aca * (cb - b)) >> 16));
-				pix[i + 1] = uchar(g + ((aca * (cg - g)) >> 16));
-				pix[i + 2] = uchar(r + ((aca * (cr - r)) >> 16));
-				pix[i + 3] = uchar(a + ((aca * (0xFF - a)) >> 16));
+			for (const auto till = i + w; i != till; ++i) {
+				const auto ratio = ((*i >> 24) * ca) >> 8;
+				if (!ratio) {
+					continue;
+				}
+				*i = anim::unshifted(anim::shifted(*i) * (256 - ratio)
+					+ target * ratio);
 			}
-			i += add;
+			i += addPerLine;
 		}
 	}
 	return std::move(image);
@@ -118,6 +118,10 @@ MonoIcon::MonoIcon(const IconMask *mask, Color color, QPoint offset)
 }
 
 void MonoIcon::reset() const {
+	if (!_pixmap.isNull() && _pixmapColorKey == colorKey(_color->c)) {
+		// Palette changed, but not the color of this icon.
+		return;
+	}
 	_pixmap = QPixmap();
 	_size = QSize();
 }
@@ -299,6 +303,7 @@ void MonoIcon::createCachedPixmap() const {
 			QPixmap::fromImage(std::move(image))).first;
 	}
 	_pixmap = j->second;
+	_pixmapColorKey = key.second;
 	_size = _pixmap.size() / DevicePixelRatio();
 }
 
@@ -77,6 +77,7 @@ private:
 	QPoint _offset = { 0, 0 };
 	mutable QImage _maskImage, _colorizedImage;
 	mutable QPixmap _pixmap; // for pixmaps
+	mutable quint32 _pixmapColorKey = 0;
 	mutable QSize _size; // for rects
 
 };
@@ -18,6 +18,7 @@ namespace Webrtc {
 namespace {
 
 constexpr auto kDropFramesWhileInactive = 5 * crl::time(1000);
+constexpr auto kScaleHintTimeout = crl::time(1000);
 
 [[nodiscard]] bool GoodForRequest(
 		const QImage &image,
@@ -173,6 +174,7 @@ struct VideoTrack::Frame {
 	FrameFormat format = FrameFormat::None;
 
 	int rotation = 0;
+	crl::profile_time convertTime = 0;
 	bool displayed = false;
 	bool alpha = false;
 	bool requireARGB32 = true;
@@ -194,6 +196,9 @@ public:
 
 	[[nodiscard]] bool firstPresentHappened() const;
 
+	// Called from any thread.
+	void setScaleHint(QSize size);
+
 	// Called from the main thread.
 	void markFrameShown();
 	[[nodiscard]] not_null<Frame*> frameForPaint();
@@ -213,6 +218,7 @@ private:
 	[[nodiscard]] not_null<Frame*> getFrame(int index);
 	[[nodiscard]] not_null<const Frame*> getFrame(int index) const;
 	[[nodiscard]] int counter() const;
+	[[nodiscard]] QSize decodeSize(QSize size, int rotation) const;
 
 	bool decodeFrame(
 		const webrtc::VideoFrame &nativeVideoFrame,
@@ -222,6 +228,8 @@ private:
 	FFmpeg::SwscalePointer _decodeContext;
 
 	std::atomic<int> _counter = 0;
+	std::atomic<uint64> _scaleHint = 0;
+	std::atomic<crl::time> _scaleHintUpdated = 0;
 
 	// Main thread.
 	int _counterCycle = 0;
@@ -303,13 +311,14 @@ bool VideoTrack::Sink::decodeFrame(
 	frame->yuv420 = FrameYUV420{
 		.size = size,
 	};
-	if (!FFmpeg::GoodStorageForFrame(frame->original, size)) {
-		frame->original = FFmpeg::CreateFrameStorage(size);
+	const auto target = decodeSize(size, nativeVideoFrame.rotation());
+	if (!FFmpeg::GoodStorageForFrame(frame->original, target)) {
+		frame->original = FFmpeg::CreateFrameStorage(target);
 	}
 	_decodeContext = FFmpeg::MakeSwscalePointer(
 		size,
 		AV_PIX_FMT_YUV420P,
-		size,
+		target,
 		AV_PIX_FMT_BGRA,
 		&_decodeContext);
 	Assert(_decodeContext != nullptr);
@@ -330,18 +339,47 @@ bool VideoTrack::Sink::decodeFrame(
 	uint8_t *dst[AV_NUM_DATA_POINTERS] = { frame->original.bits(), nullptr };
 	int dstLineSize[AV_NUM_DATA_POINTERS] = { int(frame->original.bytesPerLine()), 0 };
 
+	const auto started = crl::profile();
 	sws_scale(
 		_decodeContext.get(),
 		src,
 		srcLineSize,
 		0,
-		frame->original.height(),
+		size.height(),
 		dst,
 		dstLineSize);
+	frame->convertTime = crl::profile() - started;
 
 	return true;
 }
 
+void VideoTrack::Sink::setScaleHint(QSize size) {
+	const auto packed = size.isEmpty()
+		? uint64(0)
+		: ((uint64(uint32(size.width())) << 32)
+			| uint64(uint32(size.height())));
+	_scaleHint.store(packed, std::memory_order_relaxed);
+	_scaleHintUpdated.store(crl::now(), std::memory_order_relaxed);
+}
+
+QSize VideoTrack::Sink::decodeSize(QSize size, int rotation) const {
+	const auto packed = _scaleHint.load(std::memory_order_relaxed);
+	const auto updated = _scaleHintUpdated.load(std::memory_order_relaxed);
+	if (!packed || crl::now() - updated > kScaleHintTimeout) {
+		return size;
+	}
+	auto hint = QSize(int(packed >> 32), int(packed & 0xFFFFFFFFULL));
+	if (rotation == 90 || rotation == 270) {
+		hint.transpose();
+	}
+	const auto scaled = size.scaled(hint, Qt::KeepAspectRatio);
+	return (!scaled.isEmpty()
+		&& scaled.width() < size.width()
+		&& scaled.height() < size.height())
+		? scaled
+		: size;
+}
+
 void VideoTrack::Sink::notifyFrameDecoded() {
 	crl::on_main([weak = weak_from_this()] {
 		if (const auto strong = weak.lock()) {
@@ -426,6 +464,7 @@ void VideoTrack::Sink::destroyFrameForPaint() {
 	}
 	frame->yuv420 = FrameYUV420();
 	frame->format = FrameFormat::None;
+	frame->convertTime = 0;
 }
 
 rpl::producer<> VideoTrack::Sink::renderNextFrameOnMain() const {
@@ -451,6 +490,10 @@ auto VideoTrack::sink()
 	return _sink;
 }
 
+void VideoTrack::setScaleHint(QSize size) {
+	_sink->setScaleHint(size);
+}
+
 [[nodiscard]] VideoState VideoTrack::state() const {
 	return _state.current();
 }
@@ -531,6 +574,7 @@ FrameWithInfo VideoTrack::frameWithInfo(bool requireARGB32) const {
 		.format = data.frame->format,
 		.rotation = data.frame->rotation,
 		.index = data.index,
+		.convertTime = data.frame->convertTime,
 	};
 }
 
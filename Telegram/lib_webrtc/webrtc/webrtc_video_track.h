@@ -86,6 +86,7 @@ struct FrameWithInfo {
 	FrameFormat format = FrameFormat::None;
 	int rotation = 0;
 	int index = -1;
+	crl::profile_time convertTime = 0;
 };
 
 class VideoTrack final {
@@ -103,6 +104,11 @@ public:
 	[[nodiscard]] rpl::producer<> renderNextFrame() const;
 	[[nodiscard]] std::shared_ptr<SinkInterface> sink();
 
+	// ARGB32 frames larger than this size are scaled down right away,
+	// while converting from YUV420 on the decoding thread. The hint
+	// expires if it isn't set again, so set it with each paint.
+	void setScaleHint(QSize size);
+
 	[[nodiscard]] VideoState state() const;
 	[[nodiscard]] rpl::producer<VideoState> stateValue() const;
 	[[nodiscard]] rpl::producer<VideoState> stateChanges() const;
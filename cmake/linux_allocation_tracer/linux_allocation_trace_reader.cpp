@@ -7,14 +7,21 @@
 #include <iostream>
 #include <iomanip>
 #include <locale>
+#include <map>
 #include <unordered_map>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <ctime>
+#include <string>
 #include <vector>
 
 constexpr auto kBufferSize = 1024 * 1024;
 char Buffer[kBufferSize];
 
+constexpr auto kSampledRateInterval = 60;
+constexpr auto kSampledTopCallSites = 20;
+
 struct Fields {
     std::uint32_t time = 0;
     std::size_t mallocs = 0;
@@ -27,6 +34,26 @@ Fields State;
 std::unordered_map<std::uint64_t, std::size_t> Map;
 std::vector<Fields> Snapshots;
 
+struct Sample {
+    std::uint64_t sequence = 0;
+    std::uint64_t size = 0;
+    std::uint64_t address = 0;
+    std::size_t stack = 0;
+    std::uint32_t time = 0;
+    bool free = false;
+};
+struct Mapping {
+    std::uint64_t start = 0;
+    std::uint64_t end = 0;
+    std::uint64_t offset = 0;
+    std::string path;
+};
+std::uint64_t SampleBytes = 0;
+std::vector<Sample> Samples;
+std::vector<std::vector<std::uint64_t>> Stacks;
+std::map<std::vector<std::uint64_t>, std::size_t> StackIndices;
+std::vector<Mapping> Mappings;
+
 void WriteTime(std::uint32_t time) {
     std::time_t t = std::time_t(time);
     const auto parsed = std::localtime(&t);
@@ -117,6 +144,69 @@ void ParseFree(const char *buffer) {
     }
 }
 
+void ParseSampledHeader(const char *buffer) {
+    SampleBytes = *reinterpret_cast<const std::uint64_t*>(buffer);
+}
+
+void ParseSampledMalloc(const char *buffer, std::uint32_t time) {
+    auto sample = Sample();
+    sample.sequence = *reinterpret_cast<const std::uint64_t*>(buffer);
+    sample.size = *reinterpret_cast<const std::uint64_t*>(buffer + 8);
+    sample.address = *reinterpret_cast<const std::uint64_t*>(buffer + 16);
+    sample.time = time;
+    const auto depth = std::uint8_t(buffer[24]);
+    const auto frames = reinterpret_cast<const std::uint64_t*>(buffer + 25);
+    auto stack = std::vector<std::uint64_t>(frames, frames + depth);
+    const auto i = StackIndices.find(stack);
+    if (i != end(StackIndices)) {
+        sample.stack = i->second;
+    } else {
+        sample.stack = Stacks.size();
+        StackIndices.emplace(stack, sample.stack);
+        Stacks.push_back(std::move(stack));
+    }
+    Samples.push_back(sample);
+}
+
+void ParseSampledFree(const char *buffer, std::uint32_t time) {
+    auto sample = Sample();
+    sample.sequence = *reinterpret_cast<const std::uint64_t*>(buffer);
+    sample.address = *reinterpret_cast<const std::uint64_t*>(buffer + 8);
+    sample.time = time;
+    sample.free = true;
+    Samples.push_back(sample);
+}
+
+void ParseSampledMaps(const char *buffer) {
+    const auto size = *reinterpret_cast<const std::uint32_t*>(buffer);
+    const auto maps = std::string(buffer + 4, size);
+    auto from = std::size_t(0);
+    while (from < maps.size()) {
+        auto till = maps.find('\n', from);
+        if (till == std::string::npos) {
+            till = maps.size();
+        }
+        const auto line = maps.substr(from, till - from);
+        from = till + 1;
+
+        auto mapping = Mapping();
+        auto path = 0;
+        if (sscanf(
+                line.c_str(),
+                "%lx-%lx %*s %lx %*s %*s %n",
+                &mapping.start,
+                &mapping.end,
+                &mapping.offset,
+                &path) < 3
+            || !path
+            || path >= int(line.size())) {
+            continue;
+        }
+        mapping.path = line.substr(path);
+        Mappings.push_back(std::move(mapping));
+    }
+}
+
 long Parse(const char *buffer, const char *end) {
     auto result = 0;
     while (end > buffer) {
@@ -126,6 +216,21 @@ long Parse(const char *buffer, const char *end) {
         case 1: entry = 5 + 2 * sizeof(std::uint64_t); break;
         case 2: entry = 5 + 3 * sizeof(std::uint64_t); break;
         case 3: entry = 5 + sizeof(std::uint64_t); break;
+        case 4: entry = 5 + sizeof(std::uint64_t); break;
+        case 5: {
+            constexpr auto fixed = 5 + 3 * int(sizeof(std::uint64_t)) + 1;
+            entry = (end - buffer < fixed)
+                ? fixed
+                : (fixed + std::uint8_t(buffer[fixed - 1]) * 8);
+        } break;
+        case 6: entry = 5 + 2 * sizeof(std::uint64_t); break;
+        case 7: {
+            constexpr auto fixed = 5 + int(sizeof(std::uint32_t));
+            entry = (end - buffer < fixed)
+                ? fixed
+                : (fixed + *reinterpret_cast<const std::uint32_t*>(
+                    buffer + 5));
+        } break;
         default:
             std::cout
                 << "WARNING: Garbage in trace file, command: "
@@ -139,7 +244,9 @@ long Parse(const char *buffer, const char *end) {
         }
         const auto time = *reinterpret_cast<const std::uint32_t*>(++buffer);
         buffer += 4;
-        if (time > State.time) {
+        if (command > 3) {
+            // Sampled entries come in per-thread blocks, not in time order.
+        } else if (time > State.time) {
             PrintState();
             State.time = time;
         } else if (time < State.time) {
@@ -155,6 +262,10 @@ long Parse(const char *buffer, const char *end) {
         case 1: ParseMalloc(buffer); break;
         case 2: ParseRealloc(buffer); break;
         case 3: ParseFree(buffer); break;
+        case 4: ParseSampledHeader(buffer); break;
+        case 5: ParseSampledMalloc(buffer, time); break;
+        case 6: ParseSampledFree(buffer, time); break;
+        case 7: ParseSampledMaps(buffer); break;
         }
         buffer += entry - 5;
         result += entry;
@@ -162,6 +273,128 @@ long Parse(const char *buffer, const char *end) {
     return result;
 }
 
+std::string ResolveFrame(std::uint64_t address) {
+    auto result = std::string();
+    char hex[32];
+    for (const auto &mapping : Mappings) {
+        if (address >= mapping.start && address < mapping.end) {
+            const auto offset = address - mapping.start + mapping.offset;
+            sprintf(hex, "0x%lx", offset);
+            return mapping.path + " + " + hex;
+        }
+    }
+    sprintf(hex, "0x%lx", address);
+    return hex;
+}
+
+// Estimated amount of bytes that a sampled allocation stands for.
+double SampleWeight(std::uint64_t size) {
+    const auto bytes = double(size);
+    const auto probability = 1. - std::exp(-bytes / double(SampleBytes));
+    return (probability > 0.) ? (bytes / probability) : double(SampleBytes);
+}
+
+void PrintSampled() {
+    std::sort(begin(Samples), end(Samples), [](
+            const Sample &a,
+            const Sample &b) {
+        return a.sequence < b.sequence;
+    });
+
+    struct Live {
+        double bytes = 0.;
+        std::size_t stack = 0;
+    };
+    auto live = std::unordered_map<std::uint64_t, Live>();
+    auto liveByStack = std::vector<double>(Stacks.size());
+    auto samplesByStack = std::vector<std::size_t>(Stacks.size());
+    auto liveFull = 0.;
+    auto allocated = 0.;
+    auto interval = std::uint32_t(0);
+    const auto printInterval = [&] {
+        WriteTime(interval);
+        std::cout
+            << ": live ~"
+            << std::setw(13) << std::setfill(' ') << std::uint64_t(liveFull)
+            << ", allocated ~"
+            << std::setw(13) << std::setfill(' ') << std::uint64_t(allocated)
+            << " per "
+            << kSampledRateInterval
+            << " seconds"
+            << std::endl;
+    };
+
+    class NumPunct final : public std::numpunct<char> {
+    protected:
+        char do_thousands_sep() const override { return '\''; }
+        std::string do_grouping() const override { return "\03"; }
+    };
+
+    const auto &locale = std::cout.getloc();
+    std::cout.imbue(std::locale(std::locale::classic(), new NumPunct()));
+    std::cout
+        << "Sampled allocations, one per "
+        << SampleBytes
+        << " bytes:"
+        << std::endl;
+    for (const auto &sample : Samples) {
+        if (!interval) {
+            interval = sample.time;
+        } else if (sample.time >= interval + kSampledRateInterval) {
+            printInterval();
+            allocated = 0.;
+            interval += ((sample.time - interval) / kSampledRateInterval)
+                * kSampledRateInterval;
+        }
+        if (sample.free) {
+            const auto i = live.find(sample.address);
+            if (i != end(live)) {
+                liveByStack[i->second.stack] -= i->second.bytes;
+                liveFull -= i->second.bytes;
+                live.erase(i);
+            }
+        } else {
+            const auto bytes = SampleWeight(sample.size);
+            live[sample.address] = Live{ bytes, sample.stack };
+            liveByStack[sample.stack] += bytes;
+            ++samplesByStack[sample.stack];
+            liveFull += bytes;
+            allocated += bytes;
+        }
+    }
+    if (interval) {
+        printInterval();
+    }
+
+    auto order = std::vector<std::size_t>(Stacks.size());
+    for (auto i = std::size_t(0); i != order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(begin(order), end(order), [&](std::size_t a, std::size_t b) {
+        return liveByStack[a] > liveByStack[b];
+    });
+    if (order.size() > kSampledTopCallSites) {
+        order.resize(kSampledTopCallSites);
+    }
+    std::cout << "Live memory by call site:" << std::endl;
+    for (const auto index : order) {
+        if (liveByStack[index] < 1.) {
+            break;
+        }
+        std::cout
+            << "~"
+            << std::uint64_t(liveByStack[index])
+            << " bytes, "
+            << samplesByStack[index]
+            << " samples:"
+            << std::endl;
+        for (const auto frame : Stacks[index]) {
+            std::cout << "    " << ResolveFrame(frame) << std::endl;
+        }
+    }
+    std::cout.imbue(locale);
+}
+
 int main(int argc, char *argv[]) {
     if (argc != 2) {
         std::cout
@@ -200,6 +433,10 @@ int main(int argc, char *argv[]) {
             std::memmove(Buffer, Buffer + parsed, data - Buffer);
         }
     }
+    if (SampleBytes) {
+        PrintSampled();
+        return 0;
+    }
     PrintState();
     std::cout << "Mallocs: " << State.mallocs << "." << std::endl;
     std::cout << "Reallocs: " << State.reallocs << "." << std::endl;